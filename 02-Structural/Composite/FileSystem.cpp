@@ -3,8 +3,28 @@
 #include <memory>
 #include <string>
 #include<algorithm>
+#include <stdexcept>
+
+class Directory;
+
 // Component - Abstract base class
 class FileSystemComponent {
+private:
+    // Non-owning back link, set by Directory::add and cleared by remove; the parent owns us
+    FileSystemComponent* parent = nullptr;
+    friend class Directory;
+
+    // Directories override this to fold a child's size change into their cached total
+    virtual void childSizeChanged(int) {}
+
+protected:
+    // Pushes a size change up to the parent, which forwards it to its own parent, and so on
+    void notifyParent(int delta) {
+        if (parent && delta != 0) {
+            parent->childSizeChanged(delta);
+        }
+    }
+
 public:
     virtual ~FileSystemComponent() = default;
     virtual void display(int depth = 0) const = 0;
@@ -42,6 +62,13 @@ public:
     std::string getName() const override {
         return name;
     }
+
+    // Every directory above this file sees the change in O(depth)
+    void setSize(int newSize) {
+        int delta = newSize - size;
+        size = newSize;
+        notifyParent(delta);
+    }
 };
 
 // Composite - Directory
@@ -51,9 +78,22 @@ private:
     //std::vector<std::shared_ptr<FileSystemComponent>> instead of std::vector<FileSystemComponent> -
     // we need reference semantics to support polymorphism and avoid object slicing!
     std::vector<std::shared_ptr<FileSystemComponent>> children;
+    int cachedSize = 0;  // sum of the children's sizes, kept current by add/remove/child updates
+
+    void childSizeChanged(int delta) override {
+        cachedSize += delta;
+        notifyParent(delta);
+    }
     
 public:
     Directory(const std::string& name) : name(name) {}
+
+    ~Directory() override {
+        // Children may outlive us through other shared_ptrs; don't leave them a dangling parent
+        for (const auto& child : children) {
+            child->parent = nullptr;
+        }
+    }
     
     void display(int depth = 0) const override {
         std::string indent(depth * 2, ' ');
@@ -65,12 +105,9 @@ public:
         }
     }
     
+    // O(1): the total is maintained incrementally instead of walking the subtree
     int getSize() const override {
-        int totalSize = 0;
-        for (const auto& child : children) {
-            totalSize += child->getSize();
-        }
-        return totalSize;
+        return cachedSize;
     }
     
     std::string getName() const override {
@@ -78,13 +115,26 @@ public:
     }
     
     void add(std::shared_ptr<FileSystemComponent> component) override {
+        for (const FileSystemComponent* ancestor = this; ancestor; ancestor = ancestor->parent) {
+            if (ancestor == component.get()) {
+                throw std::invalid_argument("Cannot add a directory to itself or its own subtree");
+            }
+        }
+        // A component lives in one directory at a time: adding it elsewhere moves it
+        if (component->parent) {
+            component->parent->remove(component);
+        }
         children.push_back(component);
+        component->parent = this;
+        childSizeChanged(component->getSize());
     }
     
     void remove(std::shared_ptr<FileSystemComponent> component) override {
         auto it = std::find(children.begin(), children.end(), component);
         if (it != children.end()) {
             children.erase(it);
+            component->parent = nullptr;
+            childSizeChanged(-component->getSize());
         }
     }
     
@@ -145,6 +195,12 @@ int main() {
     imagesDir->remove(newFile);
     std::cout << "Updated structure: " << std::endl;
     imagesDir->display();
+
+    // Size changes and moves update every cached total on the way up
+    std::cout << std::endl << "Growing document.txt and moving readme.md into documents..." << std::endl;
+    file1->setSize(4096);
+    documentsDir->add(file4);
+    rootDir->display();
     return 0;
 }
 
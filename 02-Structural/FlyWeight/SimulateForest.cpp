@@ -3,6 +3,36 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <string_view>
+#include <cstdint>
+#include <functional>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <utility>
+#include <sstream>
+#include <optional>
+#include <bit>
+// POSIX, for mapping forest snapshots; other platforms read the snapshot into memory instead
+#if defined(__unix__) || defined(__APPLE__)
+#define FOREST_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define FOREST_HAS_MMAP 0
+#endif
 //The Flyweight pattern is a structural design pattern that minimizes memory usage by efficiently sharing data among multiple similar objects.
 //when you need to create a large number of objects that have some common characteristics.
 /*TreeType (Flyweight): Stores shared data (tree name and color) that multiple trees can use
@@ -24,41 +54,233 @@ class TreeType{
             std::cout << name_ << "tree (" << color_ << ") at position (" 
                   << x << ", " << y << ")\n";
         }
+        const std::string& getName() const { return name_; }
+        const std::string& getColor() const { return color_; }
+        // Same line as render(), appended to a caller-owned buffer instead of the stream
+        void renderTo(std::string& out, int x, int y) const{
+            out += name_;
+            out += "tree (";
+            out += color_;
+            out += ") at position (";
+            appendInt(out, x);
+            out += ", ";
+            appendInt(out, y);
+            out += ")\n";
+        }
+    private:
+        static void appendInt(std::string& out, int v){
+            char digits[16];
+            auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), v);
+            out.append(digits, end);
+        }
 };
+// Dense integer handle for a flyweight; doubles as its index in the factory's flat table
+using TreeTypeId = uint32_t;
+
 // Flyweight factory manages and shares flyweight class instances
+// Interning layer: (name, color) -> dense TreeTypeId through one hash probe on string_views
+// (no key string is built), then a flat table indexed by that id.
+// Thread-safe without copying: types live in an append-only table of doubling chunks that never
+// move, and the id map is an open-addressing table of atomic slots. Lookups are lock-free;
+// only creating a new type takes the mutex, and it writes a single slot (plus an O(n) rehash
+// when the map doubles, so inserts are amortized O(1) and memory stays linear in the types).
 class TreeTypeFactory{
     private:
-        // declaration of static member variable
-        static std::unordered_map<std::string, std::shared_ptr<TreeType>> treeTypes_; // name_color -> TreeType(shared_ptr , same object can be shared)
-      // inline static - no separate definition needed!
-    //inline static std::unordered_map<std::string, std::shared_ptr<TreeType>> treeTypes_;
+        struct TypeKeyView {
+            std::string_view name;
+            std::string_view color;
+        };
+        static uint64_t hashKey(const TypeKeyView& k){
+            uint64_t h = std::hash<std::string_view>{}(k.name);
+            return h ^ (std::hash<std::string_view>{}(k.color) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+        }
+
+        // Chunk c holds kFirstChunk << c types, so the first n chunks hold kFirstChunk * (2^n - 1).
+        // 26 chunks stop 64 ids short of 2^32; the 27th covers the rest of the 32-bit range.
+        static constexpr size_t kFirstChunk = 64;
+        static constexpr size_t kChunks = 27;
+        static size_t chunkOf(TreeTypeId id){
+            return std::bit_width(id / kFirstChunk + 1) - 1;
+        }
+        static size_t offsetIn(TreeTypeId id, size_t chunk){
+            return id - kFirstChunk * ((size_t{1} << chunk) - 1);
+        }
+
+        // Slot = (hash tag << 32) | (id + 1); 0 is empty. Slots are only ever filled, never
+        // cleared, so a reader that sees a filled slot can trust it.
+        struct IdTable {
+            size_t mask;
+            std::unique_ptr<std::atomic<uint64_t>[]> slots;
+            explicit IdTable(size_t capacity) : mask(capacity - 1), slots(new std::atomic<uint64_t>[capacity]) {
+                for (size_t i = 0; i < capacity; ++i) slots[i].store(0, std::memory_order_relaxed);
+            }
+        };
+        static uint64_t slotFor(uint64_t hash, TreeTypeId id){
+            return (hash >> 32 << 32) | (uint64_t{id} + 1);
+        }
+
+        // declaration of static member variables
+        static std::atomic<std::shared_ptr<TreeType>*> chunks_[kChunks]; // id -> TreeType(shared_ptr , same object can be shared)
+        static std::atomic<const IdTable*> ids_;  // (name, color) -> id
+        static std::atomic<TreeTypeId> count_;
+        static std::mutex createMutex_;  // serializes creation of new types
+        // Owners of the chunks and of every id table; a reader may still probe an outgrown table.
+        // Tables double, so all of them together are under twice the current one.
+        static std::vector<std::unique_ptr<std::shared_ptr<TreeType>[]>> ownedChunks_;
+        static std::vector<std::unique_ptr<IdTable>> ownedTables_;
+
+        static const std::shared_ptr<TreeType>& typeAt(TreeTypeId id){
+            size_t chunk = chunkOf(id);
+            return chunks_[chunk].load(std::memory_order_acquire)[offsetIn(id, chunk)];
+        }
+
+        static std::optional<TreeTypeId> find(const IdTable* table, const TypeKeyView& key, uint64_t hash){
+            if (!table) return std::nullopt;
+            for (size_t i = hash & table->mask;; i = (i + 1) & table->mask) {
+                uint64_t slot = table->slots[i].load(std::memory_order_acquire);
+                if (slot == 0) return std::nullopt;
+                if (slot >> 32 != hash >> 32) continue;
+                TreeTypeId id = static_cast<TreeTypeId>(slot & 0xffffffffu) - 1;
+                const TreeType& type = *typeAt(id);
+                if (type.getName() == key.name && type.getColor() == key.color) return id;
+            }
+        }
+
+        // Caller holds createMutex_
+        static void insertLocked(const IdTable& table, uint64_t hash, TreeTypeId id){
+            size_t i = hash & table.mask;
+            while (table.slots[i].load(std::memory_order_relaxed) != 0) i = (i + 1) & table.mask;
+            table.slots[i].store(slotFor(hash, id), std::memory_order_release);
+        }
+
+        // Caller holds createMutex_; keeps the load factor at or below 1/2
+        static const IdTable& tableWithRoomLocked(){
+            const IdTable* current = ids_.load(std::memory_order_relaxed);
+            size_t count = count_.load(std::memory_order_relaxed);
+            if (current && (count + 1) * 2 <= current->mask + 1) return *current;
+            auto grown = std::make_unique<IdTable>(current ? 2 * (current->mask + 1) : 64);
+            for (TreeTypeId id = 0; id < count; ++id) {
+                const TreeType& type = *typeAt(id);
+                insertLocked(*grown, hashKey(TypeKeyView{type.getName(), type.getColor()}), id);
+            }
+            ids_.store(grown.get(), std::memory_order_release);
+            ownedTables_.push_back(std::move(grown));
+            return *ownedTables_.back();
+        }
     public:
+        // One lock-free lookup; only a brand-new type locks and allocates (its flyweight)
+        static TreeTypeId getTypeId(std::string_view name, std::string_view color){
+            TypeKeyView key{name, color};
+            uint64_t hash = hashKey(key);
+            if (auto found = find(ids_.load(std::memory_order_acquire), key, hash)){
+                return *found;   // return exsiting flyweight id if found
+            }
+            std::lock_guard<std::mutex> lock(createMutex_);
+            // Another thread may have created it while we waited
+            if (auto found = find(ids_.load(std::memory_order_acquire), key, hash)){
+                return *found;
+            }
+            // Create new flyweight if not found
+            TreeTypeId id = count_.load(std::memory_order_relaxed);
+            if (id == std::numeric_limits<TreeTypeId>::max() - 1) throw std::length_error("Too many tree types");
+            std::cout << "Creating new flyweight #" << id << " for " << name << " _ " << color << std::endl;
+            size_t chunk = chunkOf(id);
+            if (!chunks_[chunk].load(std::memory_order_relaxed)) {
+                ownedChunks_.emplace_back(new std::shared_ptr<TreeType>[kFirstChunk << chunk]);
+                chunks_[chunk].store(ownedChunks_.back().get(), std::memory_order_release);
+            }
+            const IdTable& table = tableWithRoomLocked();
+            // The type is in place before its slot is published, so a reader that finds the id
+            // also sees the flyweight
+            chunks_[chunk].load(std::memory_order_relaxed)[offsetIn(id, chunk)] =
+                std::make_shared<TreeType>(std::string(name), std::string(color));
+            count_.store(id + 1, std::memory_order_release);
+            insertLocked(table, hash, id);
+            return id;
+        }
+        // id must come from getTypeId
+        static const std::shared_ptr<TreeType>& getTreeType(TreeTypeId id){
+            return typeAt(id);
+        }
         static std::shared_ptr<TreeType> getTreeType(const std::string &name, const std::string &color){
-            std::string key = name + " _ " + color;
-        
-        // return exsiting flyweight object if found
-        if (treeTypes_.find(key) != treeTypes_.end()){
-            std::cout << "Reusing existing flyweight for " << key << std::endl;
-            std::cout << "Address of Tree from MAP BEFORE rendering:\n";
-            std::cout << treeTypes_[key] << std::endl;
-            return treeTypes_[key];
-        }
-        // Create new flyweight if not found
-        std::cout << "Creating new flyweight for " << key << std::endl;
-        treeTypes_[key] = std::make_shared<TreeType>(name, color);
-        std::cout << "Address of Tree from MAP BEFORE rendering:\n";
-        std::cout << treeTypes_[key] << std::endl;
-        return treeTypes_[key];
-    }
+            return getTreeType(getTypeId(name, color));
+        }
     static int getFlyweightCount(){
-        return treeTypes_.size();
+        return count_.load(std::memory_order_acquire);
     }
 };
-// Intialize treeType_  defining (allocating memory for) a static member variable that was declared inside the TreeTypeFactory class.
-std::unordered_map<std::string, std::shared_ptr<TreeType>> TreeTypeFactory::treeTypes_; //Compatibility: Works with all C++ standards
+// Intialize the tables: defining (allocating memory for) static member variables that were declared inside the TreeTypeFactory class.
+std::atomic<std::shared_ptr<TreeType>*> TreeTypeFactory::chunks_[TreeTypeFactory::kChunks] = {}; //Compatibility: Works with all C++ standards
+std::atomic<const TreeTypeFactory::IdTable*> TreeTypeFactory::ids_{nullptr};
+std::atomic<TreeTypeId> TreeTypeFactory::count_{0};
+std::mutex TreeTypeFactory::createMutex_;
+std::vector<std::unique_ptr<std::shared_ptr<TreeType>[]>> TreeTypeFactory::ownedChunks_;
+std::vector<std::unique_ptr<TreeTypeFactory::IdTable>> TreeTypeFactory::ownedTables_;
 //// Outside class - definition with initial value
 // std::unordered_map<std::string, std::shared_ptr<TreeType>> 
 //     TreeTypeFactory::treeTypes_ = {}; // Initialize as empty
+// Render pipeline: [0, count) is split into chunks that worker threads format in parallel
+// (format(begin, end, buffer) appends one chunk's text), while the calling thread writes the
+// finished chunks to out in order, one write per chunk. At most 2 * workers chunks are
+// buffered at a time and their strings are recycled, so memory stays flat on huge forests.
+template <typename Format>
+void renderChunked(std::ostream& out, size_t count, size_t chunkSize, unsigned workers, Format format){
+    if (count == 0) return;
+    if (chunkSize == 0) chunkSize = 1;
+    if (workers == 0) workers = std::max(1u, std::thread::hardware_concurrency());
+    const size_t chunks = (count + chunkSize - 1) / chunkSize;
+    workers = static_cast<unsigned>(std::min<size_t>(workers, chunks));
+    const size_t window = 2 * static_cast<size_t>(workers);
+
+    std::vector<std::string> slots(window);
+    std::vector<char> ready(window, 0);
+    size_t written = 0;  // chunks already handed to out
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::atomic<size_t> nextChunk{0};
+
+    auto work = [&] {
+        std::string buffer;  // per-thread buffer, swapped with a recycled slot after each chunk
+        for (size_t c; (c = nextChunk.fetch_add(1)) < chunks;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [&] { return c < written + window; });
+            }
+            buffer.clear();
+            size_t begin = c * chunkSize;
+            format(begin, std::min(count, begin + chunkSize), buffer);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                slots[c % window].swap(buffer);
+                ready[c % window] = 1;
+            }
+            changed.notify_all();
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned i = 0; i < workers; ++i) pool.emplace_back(work);
+
+    std::string chunk;
+    for (size_t c = 0; c < chunks; ++c) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [&] { return ready[c % window] != 0; });
+            chunk.swap(slots[c % window]);
+            ready[c % window] = 0;
+        }
+        out.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        chunk.clear();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            slots[c % window].swap(chunk);  // give the capacity back to the next producer
+            ++written;
+        }
+        changed.notify_all();
+    }
+    for (auto& t : pool) t.join();
+    out.flush();
+}
+
 // Context class - stores the extrinsic state (unique data per new object)
 class Tree{
     private:
@@ -70,18 +292,26 @@ class Tree{
             x_ = x, y_ = y;
             treeType_  = TreeTypeFactory::getTreeType(name, color);
         }
+        Tree(int x, int y, TreeTypeId type) : x_(x), y_(y), treeType_(TreeTypeFactory::getTreeType(type)) {}
         // pass extrinsic state to flyweight
         void render() const{
             treeType_->render(x_, y_);
         }
+        void renderTo(std::string& out) const{
+            treeType_->renderTo(out, x_, y_);
+        }
 };
 // Client Class that uses many objects
 class Forest{
     private:
         std::vector<Tree> trees_;
     public:
-        void plantTree(int x, int y, const std::string & name, const std::string &color){
-            trees_.emplace_back(x,y,name, color);// THIS will create a new Tree object
+        void plantTree(int x, int y, std::string_view name, std::string_view color){
+            plantTree(x, y, TreeTypeFactory::getTypeId(name, color));
+        }
+        // Hot loops can intern the type once and plant by id
+        void plantTree(int x, int y, TreeTypeId type){
+            trees_.emplace_back(x, y, type);// THIS will create a new Tree object
         }
         void render() const{
             std::cout << "\nRendering forest:\n";
@@ -95,9 +325,744 @@ class Forest{
             std::cout << "\nForest Statistics:\n";
             std::cout << "Total trees: " << trees_.size() << "\n";
             std::cout << "Flyweight objects created: " << TreeTypeFactory::getFlyweightCount() << "\n";
+            std::cout << "Bytes per tree: " << sizeof(Tree) << "\n";
         }
+        // Chunked parallel formatting with one write per chunk; workers = 0 uses every core
+        void renderParallel(std::ostream& out, size_t chunkSize = 8192, unsigned workers = 0) const{
+            renderChunked(out, trees_.size(), chunkSize, workers, [this](size_t begin, size_t end, std::string& buffer) {
+                for (size_t i = begin; i < end; ++i) trees_[i].renderTo(buffer);
+            });
+        }
+};
+
+struct ForestBounds {
+    int minX, minY, maxX, maxY;
 };
 
+// Visible area, inclusive on all edges
+struct Viewport {
+    int minX, minY, maxX, maxY;
+    bool contains(int x, int y) const { return x >= minX && x <= maxX && y >= minY && y <= maxY; }
+};
+
+// Binary forest snapshot, native byte order:
+//   header | type table (u16 name length, u16 color length, name, color)... | 8-byte aligned
+//   columns: x, y (int32, or uint16 grid steps when quantized), then uint16 type ids.
+// Type ids in the file index its own type table, not the process-wide factory.
+struct ForestFileHeader {
+    char magic[4];          // "FRST"
+    uint32_t version;
+    uint64_t treeCount;
+    uint32_t typeCount;
+    uint32_t quantized;     // 1 when x/y are uint16 steps from origin
+    int32_t originX, originY, step;
+    uint32_t reserved;
+    uint64_t typesOffset, xOffset, yOffset, typeIdOffset;
+};
+constexpr char kForestMagic[4] = {'F', 'R', 'S', 'T'};
+constexpr uint32_t kForestVersion = 1;
+
+// Uniform grid over tree positions: each cell lists the indices of the trees inside it.
+// Insertion is O(1), so the index is kept current as trees are planted; a viewport query
+// touches only the overlapping cells, i.e. time proportional to the visible trees.
+class SpatialGrid {
+    private:
+        int cellSize_;
+        std::unordered_map<uint64_t, std::vector<uint32_t>> cells_;
+
+        // floor division, so negative coordinates land in the right cell
+        int cellOf(int v) const { return v >= 0 ? v / cellSize_ : -((-v + cellSize_ - 1) / cellSize_); }
+        static uint64_t key(int cx, int cy) {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+        }
+    public:
+        explicit SpatialGrid(int cellSize) : cellSize_(cellSize) {
+            if (cellSize_ <= 0) throw std::invalid_argument("Grid cell size must be positive");
+        }
+
+        void insert(int x, int y, uint32_t index) {
+            cells_[key(cellOf(x), cellOf(y))].push_back(index);
+        }
+
+        // Calls fn(index) for every tree in a cell overlapping the viewport; the caller
+        // still filters on exact position for the partially covered border cells
+        template <typename Fn>
+        void query(const Viewport& v, Fn&& fn) const {
+            int cx0 = cellOf(v.minX), cx1 = cellOf(v.maxX);
+            int cy0 = cellOf(v.minY), cy1 = cellOf(v.maxY);
+            // A huge viewport over a sparse grid: walking the occupied cells is cheaper
+            if (static_cast<uint64_t>(cx1 - cx0 + 1) * static_cast<uint64_t>(cy1 - cy0 + 1) > cells_.size()) {
+                for (const auto& [k, indices] : cells_) {
+                    int cx = static_cast<int>(static_cast<uint32_t>(k >> 32));
+                    int cy = static_cast<int>(static_cast<uint32_t>(k));
+                    if (cx < cx0 || cx > cx1 || cy < cy0 || cy > cy1) continue;
+                    for (uint32_t i : indices) fn(i);
+                }
+                return;
+            }
+            for (int cx = cx0; cx <= cx1; ++cx) {
+                for (int cy = cy0; cy <= cy1; ++cy) {
+                    auto found = cells_.find(key(cx, cy));
+                    if (found == cells_.end()) continue;
+                    for (uint32_t i : found->second) fn(i);
+                }
+            }
+        }
+
+        size_t cellCount() const { return cells_.size(); }
+};
+
+// Structure-of-arrays Forest mode: no Tree objects, just parallel columns x[], y[], type[].
+// Type ids are 16-bit and no shared_ptr is copied per tree, so planting does no refcount
+// traffic and traversals stream through contiguous arrays (easy for the compiler to vectorise).
+// Quantized mode stores coordinates as 16-bit offsets from an origin in steps of `step` units:
+// 6 bytes per tree instead of sizeof(Tree); positions are rounded down to the step grid.
+class CompactForest{
+    public:
+        using TypeId16 = uint16_t;
+        struct Quantization {
+            int originX = 0;
+            int originY = 0;
+            int step = 1;
+        };
+    private:
+        bool quantized_;
+        Quantization q_;
+        std::vector<int32_t> xs_, ys_;    // full-precision columns
+        std::vector<uint16_t> qx_, qy_;   // quantized columns
+        std::vector<TypeId16> types_;
+        std::unique_ptr<SpatialGrid> grid_;  // optional, see enableSpatialIndex
+
+        int xAt(size_t i) const { return quantized_ ? q_.originX + qx_[i] * q_.step : xs_[i]; }
+        int yAt(size_t i) const { return quantized_ ? q_.originY + qy_[i] * q_.step : ys_[i]; }
+
+        uint16_t quantize(int value, int origin) const {
+            long offset = (static_cast<long>(value) - origin) / q_.step;
+            if (value < origin || offset > std::numeric_limits<uint16_t>::max()) {
+                throw std::out_of_range("Tree position outside the quantized forest area");
+            }
+            return static_cast<uint16_t>(offset);
+        }
+
+        // "x,y,name,color" with no quoting; false if any field is missing, not a number, or extra
+        static bool parseCsvRow(std::string_view line, int& x, int& y, std::string_view& name, std::string_view& color) {
+            const char* p = line.data();
+            const char* end = p + line.size();
+            auto number = [&](int& out) {
+                auto [next, ec] = std::from_chars(p, end, out);
+                if (ec != std::errc() || next == end || *next != ',') return false;
+                p = next + 1;
+                return true;
+            };
+            if (!number(x) || !number(y)) return false;
+            const char* comma = static_cast<const char*>(std::memchr(p, ',', static_cast<size_t>(end - p)));
+            if (!comma) return false;
+            name = std::string_view(p, static_cast<size_t>(comma - p));
+            color = std::string_view(comma + 1, static_cast<size_t>(end - comma - 1));
+            return !name.empty() && !color.empty() && color.find(',') == std::string_view::npos;
+        }
+
+    public:
+        CompactForest() : quantized_(false) {}
+        explicit CompactForest(Quantization q) : quantized_(true), q_(q) {
+            if (q_.step <= 0) throw std::invalid_argument("Quantization step must be positive");
+        }
+
+        void reserve(size_t n){
+            if (quantized_) {
+                qx_.reserve(n);
+                qy_.reserve(n);
+            } else {
+                xs_.reserve(n);
+                ys_.reserve(n);
+            }
+            types_.reserve(n);
+        }
+
+        // Growth for appends of unknown total size: doubling keeps reallocation amortized O(1)
+        // per tree, where reserving exactly each time would copy every column on every call
+        void reserveForAppend(size_t n){
+            if (n > types_.capacity()) reserve(std::max(n, 2 * types_.capacity()));
+        }
+
+        void plantTree(int x, int y, std::string_view name, std::string_view color){
+            plantTree(x, y, TreeTypeFactory::getTypeId(name, color));
+        }
+        void plantTree(int x, int y, TreeTypeId type){
+            if (type > std::numeric_limits<TypeId16>::max()) {
+                throw std::out_of_range("CompactForest supports at most 65536 tree types");
+            }
+            if (quantized_) {
+                // Quantize both before pushing either, so a rejected y leaves the columns aligned
+                uint16_t qx = quantize(x, q_.originX);
+                uint16_t qy = quantize(y, q_.originY);
+                qx_.push_back(qx);
+                qy_.push_back(qy);
+            } else {
+                xs_.push_back(x);
+                ys_.push_back(y);
+            }
+            types_.push_back(static_cast<TypeId16>(type));
+            if (grid_) grid_->insert(xAt(types_.size() - 1), yAt(types_.size() - 1), static_cast<uint32_t>(types_.size() - 1));
+        }
+
+        // Builds a grid over the trees planted so far and keeps it updated on every plantTree.
+        // Pick cellSize near the typical viewport size divided by a small factor.
+        void enableSpatialIndex(int cellSize){
+            grid_ = std::make_unique<SpatialGrid>(cellSize);
+            for (size_t i = 0; i < types_.size(); ++i) grid_->insert(xAt(i), yAt(i), static_cast<uint32_t>(i));
+        }
+
+        // Visits the trees inside the viewport as (x, y, typeId); uses the grid when enabled,
+        // otherwise scans every tree
+        template <typename Fn>
+        void forEachVisible(const Viewport& view, Fn&& fn) const{
+            if (!grid_) {
+                forEach([&](int x, int y, TypeId16 type) {
+                    if (view.contains(x, y)) fn(x, y, type);
+                });
+                return;
+            }
+            grid_->query(view, [&](uint32_t i) {
+                int x = xAt(i), y = yAt(i);
+                if (view.contains(x, y)) fn(x, y, types_[i]);
+            });
+        }
+
+        size_t size() const { return types_.size(); }
+
+        // Visits every tree as (x, y, typeId); the storage mode is resolved once, not per tree
+        template <typename Fn>
+        void forEach(Fn&& fn) const{
+            forEachInRange(0, types_.size(), fn);
+        }
+
+        // Same as forEach over the trees [begin, end)
+        template <typename Fn>
+        void forEachInRange(size_t begin, size_t end, Fn&& fn) const{
+            if (quantized_) {
+                for (size_t i = begin; i < end; ++i) {
+                    fn(q_.originX + qx_[i] * q_.step, q_.originY + qy_[i] * q_.step, types_[i]);
+                }
+            } else {
+                for (size_t i = begin; i < end; ++i) fn(xs_[i], ys_[i], types_[i]);
+            }
+        }
+
+        void render() const{
+            std::cout << "\nRendering compact forest:\n";
+            forEach([](int x, int y, TypeId16 type) {
+                TreeTypeFactory::getTreeType(type)->render(x, y);
+            });
+        }
+
+        // Chunked parallel formatting with one write per chunk; workers = 0 uses every core
+        void renderParallel(std::ostream& out, size_t chunkSize = 8192, unsigned workers = 0) const{
+            renderChunked(out, size(), chunkSize, workers, [this](size_t begin, size_t end, std::string& buffer) {
+                forEachInRange(begin, end, [&buffer](int x, int y, TypeId16 type) {
+                    TreeTypeFactory::getTreeType(type)->renderTo(buffer, x, y);
+                });
+            });
+        }
+
+        void render(const Viewport& view) const{
+            std::cout << "\nRendering viewport (" << view.minX << ", " << view.minY << ") - ("
+                      << view.maxX << ", " << view.maxY << "):\n";
+            forEachVisible(view, [](int x, int y, TypeId16 type) {
+                TreeTypeFactory::getTreeType(type)->render(x, y);
+            });
+        }
+
+        ForestBounds bounds() const{
+            ForestBounds b{std::numeric_limits<int>::max(), std::numeric_limits<int>::max(),
+                           std::numeric_limits<int>::min(), std::numeric_limits<int>::min()};
+            forEach([&b](int x, int y, TypeId16) {
+                b.minX = std::min(b.minX, x);
+                b.minY = std::min(b.minY, y);
+                b.maxX = std::max(b.maxX, x);
+                b.maxY = std::max(b.maxY, y);
+            });
+            return b;
+        }
+
+        // Writes the columns as-is after a table of every interned type, so ids need no remapping
+        void saveSnapshot(const std::string& path) const{
+            ForestFileHeader h{};
+            std::memcpy(h.magic, kForestMagic, sizeof(h.magic));
+            h.version = kForestVersion;
+            h.treeCount = size();
+            h.typeCount = static_cast<uint32_t>(std::min<int>(TreeTypeFactory::getFlyweightCount(), std::numeric_limits<TypeId16>::max() + 1));
+            h.quantized = quantized_ ? 1 : 0;
+            h.originX = q_.originX;
+            h.originY = q_.originY;
+            h.step = q_.step;
+            h.typesOffset = sizeof(h);
+
+            std::string table;
+            for (uint32_t id = 0; id < h.typeCount; ++id) {
+                const auto& type = TreeTypeFactory::getTreeType(id);
+                // Lengths are stored as uint16_t; fail before the file is touched rather than truncate
+                if (type->getName().size() > std::numeric_limits<uint16_t>::max() ||
+                    type->getColor().size() > std::numeric_limits<uint16_t>::max()) {
+                    throw std::length_error("Tree type name or color too long for a snapshot");
+                }
+                uint16_t lengths[2] = {static_cast<uint16_t>(type->getName().size()), static_cast<uint16_t>(type->getColor().size())};
+                table.append(reinterpret_cast<const char*>(lengths), sizeof(lengths));
+                table += type->getName();
+                table += type->getColor();
+            }
+            auto align8 = [](uint64_t v) { return (v + 7) & ~uint64_t{7}; };
+            const uint64_t coordBytes = h.treeCount * (quantized_ ? sizeof(uint16_t) : sizeof(int32_t));
+            h.xOffset = align8(h.typesOffset + table.size());
+            h.yOffset = align8(h.xOffset + coordBytes);
+            h.typeIdOffset = align8(h.yOffset + coordBytes);
+
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            if (!out) throw std::runtime_error("Cannot create " + path);
+            static const char zeros[8] = {};
+            uint64_t written = 0;
+            auto put = [&](const void* data, uint64_t bytes, uint64_t at) {
+                out.write(zeros, static_cast<std::streamsize>(at - written));  // alignment padding
+                out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+                written = at + bytes;
+            };
+            put(&h, sizeof(h), 0);
+            put(table.data(), table.size(), h.typesOffset);
+            put(quantized_ ? static_cast<const void*>(qx_.data()) : xs_.data(), coordBytes, h.xOffset);
+            put(quantized_ ? static_cast<const void*>(qy_.data()) : ys_.data(), coordBytes, h.yOffset);
+            put(types_.data(), h.treeCount * sizeof(TypeId16), h.typeIdOffset);
+            if (!out.flush()) throw std::runtime_error("Cannot write " + path);
+        }
+
+        static constexpr size_t kCsvBatchRows = 4096;
+        static constexpr size_t kCsvBlockBytes = 1 << 20;
+
+        // Streams "x,y,name,color" rows (an optional header line is skipped) in 1 MB blocks.
+        // Rows are parsed in place and planted in batches of batchRows; each distinct
+        // (name, color) is resolved through the factory once per batch. When totalBytes is
+        // known, capacity for the whole input is reserved after the first block.
+        // Returns the number of trees planted.
+        size_t plantFromCsv(std::istream& in, uint64_t totalBytes = 0, size_t batchRows = kCsvBatchRows){
+            if (batchRows == 0) batchRows = 1;
+            struct Row { int x, y; std::string_view name, color; };
+            using TypeKey = std::pair<std::string_view, std::string_view>;
+            struct TypeKeyHash {
+                size_t operator()(const TypeKey& k) const {
+                    size_t h = std::hash<std::string_view>{}(k.first);
+                    return h ^ (std::hash<std::string_view>{}(k.second) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+                }
+            };
+            std::vector<Row> batch;
+            batch.reserve(batchRows);
+            std::unordered_map<TypeKey, TreeTypeId, TypeKeyHash> cache;  // distinct types of the current batch
+            std::vector<TreeTypeId> ids(batchRows);
+
+            auto flush = [&] {
+                cache.clear();  // keys view into the current block
+                TypeKey lastKey;
+                TreeTypeId lastId = 0;
+                for (size_t i = 0; i < batch.size(); ++i) {
+                    const Row& row = batch[i];
+                    TypeKey key{row.name, row.color};
+                    // Input is usually clustered by type: try the previous row's type before hashing
+                    if (i > 0 && key == lastKey) {
+                        ids[i] = lastId;
+                        continue;
+                    }
+                    auto hit = cache.find(key);
+                    if (hit == cache.end()) {
+                        hit = cache.emplace(key, TreeTypeFactory::getTypeId(row.name, row.color)).first;
+                    }
+                    lastKey = key;
+                    lastId = ids[i] = hit->second;
+                }
+                reserveForAppend(size() + batch.size());  // no-op once the whole input was reserved
+                for (size_t i = 0; i < batch.size(); ++i) plantTree(batch[i].x, batch[i].y, ids[i]);
+                batch.clear();
+            };
+
+            std::string block, carry;
+            const size_t startSize = size();
+            size_t planted = 0, lineNo = 0;
+            bool firstBlock = true;
+            while (in) {
+                block.resize(kCsvBlockBytes);
+                in.read(block.data(), static_cast<std::streamsize>(block.size()));
+                block.resize(static_cast<size_t>(in.gcount()));
+                if (block.empty() && carry.empty()) break;
+                // Rows never straddle blocks: the tail after the last newline moves to the next block
+                block.insert(0, carry);
+                size_t end = in ? block.rfind('\n') : block.size() - 1;  // at EOF the last line may lack '\n'
+                if (end == std::string::npos) {
+                    carry.swap(block);
+                    continue;
+                }
+                carry.assign(block, end + 1, std::string::npos);
+
+                std::string_view text(block.data(), end + 1);
+                size_t rowsInBlock = 0;
+                while (!text.empty()) {
+                    size_t nl = text.find('\n');
+                    std::string_view line = text.substr(0, nl);
+                    text.remove_prefix(nl == std::string_view::npos ? text.size() : nl + 1);
+                    ++lineNo;
+                    if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+                    if (line.empty()) continue;
+                    Row row;
+                    if (!parseCsvRow(line, row.x, row.y, row.name, row.color)) {
+                        // Only a first line that does not start with a number is a header
+                        int first;
+                        if (lineNo == 1 && std::from_chars(line.data(), line.data() + line.size(), first).ec != std::errc()) continue;
+                        throw std::runtime_error("Malformed forest CSV at line " + std::to_string(lineNo));
+                    }
+                    batch.push_back(row);
+                    ++rowsInBlock;
+                    if (batch.size() == batchRows) {
+                        planted += batch.size();
+                        flush();
+                    }
+                }
+                if (firstBlock && totalBytes > 0 && rowsInBlock > 0) {
+                    // Extrapolate the row count from the first block's average row length
+                    reserve(startSize + static_cast<size_t>(totalBytes * rowsInBlock / (end + 1)) + 1);
+                }
+                firstBlock = false;
+                planted += batch.size();
+                flush();  // the batch views into this block, so finish it before reading the next
+            }
+            return planted;
+        }
+
+        size_t plantFromCsv(const std::string& path, size_t batchRows = kCsvBatchRows){
+            std::ifstream in(path, std::ios::binary);
+            if (!in) throw std::runtime_error("Cannot open " + path);
+            return plantFromCsv(in, std::filesystem::file_size(path), batchRows);
+        }
+
+        size_t memoryBytes() const{
+            return xs_.capacity() * sizeof(int32_t) + ys_.capacity() * sizeof(int32_t) +
+                   qx_.capacity() * sizeof(uint16_t) + qy_.capacity() * sizeof(uint16_t) +
+                   types_.capacity() * sizeof(TypeId16);  // excludes the optional spatial index
+        }
+
+        void showStats() const {
+            std::cout << "\nCompact Forest Statistics (" << (quantized_ ? "quantized" : "full precision") << "):\n";
+            std::cout << "Total trees: " << size() << "\n";
+            std::cout << "Flyweight objects created: " << TreeTypeFactory::getFlyweightCount() << "\n";
+            std::cout << "Bytes per tree: " << (size() ? static_cast<double>(memoryBytes()) / size() : 0.0) << "\n";
+        }
+};
+
+// Read-only forest served straight from a mapped snapshot file: loading validates the header
+// and interns the (few) types; the position and type-id columns are never parsed or copied.
+// Without mmap the file is read into one buffer instead: a single bulk read, still no per-tree work.
+class MappedForest{
+    private:
+        const std::byte* data_ = nullptr;
+        size_t size_ = 0;
+#if !FOREST_HAS_MMAP
+        std::vector<std::byte> owned_;  // operator new alignment covers every column type
+#endif
+        ForestFileHeader header_{};
+        std::vector<TreeTypeId> typeMap_;  // file type id -> factory type id
+        const int32_t* xs_ = nullptr;
+        const int32_t* ys_ = nullptr;
+        const uint16_t* qx_ = nullptr;
+        const uint16_t* qy_ = nullptr;
+        const uint16_t* types_ = nullptr;
+
+        void fail(const std::string& why){
+            unmap();
+            throw std::runtime_error("Bad forest snapshot: " + why);
+        }
+        void unmap(){
+#if FOREST_HAS_MMAP
+            if (data_) munmap(const_cast<std::byte*>(data_), size_);
+#else
+            owned_ = {};
+#endif
+            data_ = nullptr;
+            size_ = 0;
+        }
+        template <typename T>
+        const T* column(uint64_t offset){
+            uint64_t bytes = header_.treeCount * sizeof(T);
+            if (offset % alignof(T) != 0 || offset > size_ || bytes > size_ - offset) fail("column out of range");
+            return reinterpret_cast<const T*>(data_ + offset);
+        }
+    public:
+        explicit MappedForest(const std::string& path){
+#if FOREST_HAS_MMAP
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) throw std::runtime_error("Cannot open " + path);
+            struct stat st{};
+            if (fstat(fd, &st) != 0) {
+                ::close(fd);
+                throw std::runtime_error("Cannot stat " + path);
+            }
+            size_ = static_cast<size_t>(st.st_size);
+            if (size_ < sizeof(ForestFileHeader)) {
+                ::close(fd);
+                throw std::runtime_error("Bad forest snapshot: too short");
+            }
+            void* p = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);  // the mapping stays valid after the descriptor is closed
+            if (p == MAP_FAILED) throw std::runtime_error("Cannot map " + path);
+            data_ = static_cast<const std::byte*>(p);
+#else
+            std::ifstream in(path, std::ios::binary);
+            if (!in) throw std::runtime_error("Cannot open " + path);
+            owned_.resize(static_cast<size_t>(std::filesystem::file_size(path)));
+            if (owned_.size() < sizeof(ForestFileHeader)) throw std::runtime_error("Bad forest snapshot: too short");
+            if (!in.read(reinterpret_cast<char*>(owned_.data()), static_cast<std::streamsize>(owned_.size()))) {
+                throw std::runtime_error("Cannot read " + path);
+            }
+            data_ = owned_.data();
+            size_ = owned_.size();
+#endif
+
+            std::memcpy(&header_, data_, sizeof(header_));
+            if (std::memcmp(header_.magic, kForestMagic, sizeof(kForestMagic)) != 0) fail("wrong magic");
+            if (header_.version != kForestVersion) fail("unsupported version");
+            if (header_.typeCount > std::numeric_limits<CompactForest::TypeId16>::max() + 1u) fail("too many types");
+            if (header_.treeCount > size_) fail("tree count exceeds file size");
+
+            uint64_t at = header_.typesOffset;
+            typeMap_.reserve(header_.typeCount);
+            for (uint32_t i = 0; i < header_.typeCount; ++i) {
+                uint16_t lengths[2];
+                if (at > size_ || size_ - at < sizeof(lengths)) fail("type table out of range");
+                std::memcpy(lengths, data_ + at, sizeof(lengths));
+                at += sizeof(lengths);
+                if (size_ - at < uint64_t{lengths[0]} + lengths[1]) fail("type table out of range");
+                std::string_view name(reinterpret_cast<const char*>(data_ + at), lengths[0]);
+                std::string_view color(name.data() + lengths[0], lengths[1]);
+                typeMap_.push_back(TreeTypeFactory::getTypeId(name, color));
+                at += uint64_t{lengths[0]} + lengths[1];
+            }
+            if (header_.quantized) {
+                qx_ = column<uint16_t>(header_.xOffset);
+                qy_ = column<uint16_t>(header_.yOffset);
+            } else {
+                xs_ = column<int32_t>(header_.xOffset);
+                ys_ = column<int32_t>(header_.yOffset);
+            }
+            types_ = column<uint16_t>(header_.typeIdOffset);
+            // One vectorizable pass so a corrupt id can never index past the type table
+            uint16_t maxType = 0;
+            for (uint64_t i = 0; i < header_.treeCount; ++i) maxType = std::max(maxType, types_[i]);
+            if (header_.treeCount > 0 && maxType >= header_.typeCount) fail("type id out of range");
+#if FOREST_HAS_MMAP
+            madvise(const_cast<std::byte*>(data_), size_, MADV_SEQUENTIAL);
+#endif
+        }
+        ~MappedForest() { unmap(); }
+        MappedForest(const MappedForest&) = delete;
+        MappedForest& operator=(const MappedForest&) = delete;
+
+        size_t size() const { return header_.treeCount; }
+
+        // Visits the trees [begin, end) as (x, y, factory TreeTypeId)
+        template <typename Fn>
+        void forEachInRange(size_t begin, size_t end, Fn&& fn) const{
+            if (header_.quantized) {
+                for (size_t i = begin; i < end; ++i) {
+                    fn(header_.originX + qx_[i] * header_.step, header_.originY + qy_[i] * header_.step, typeMap_[types_[i]]);
+                }
+            } else {
+                for (size_t i = begin; i < end; ++i) fn(xs_[i], ys_[i], typeMap_[types_[i]]);
+            }
+        }
+        template <typename Fn>
+        void forEach(Fn&& fn) const{
+            forEachInRange(0, size(), fn);
+        }
+
+        void render() const{
+            std::cout << "\nRendering mapped forest:\n";
+            forEach([](int x, int y, TreeTypeId type) {
+                TreeTypeFactory::getTreeType(type)->render(x, y);
+            });
+        }
+        void renderParallel(std::ostream& out, size_t chunkSize = 8192, unsigned workers = 0) const{
+            renderChunked(out, size(), chunkSize, workers, [this](size_t begin, size_t end, std::string& buffer) {
+                forEachInRange(begin, end, [&buffer](int x, int y, TreeTypeId type) {
+                    TreeTypeFactory::getTreeType(type)->renderTo(buffer, x, y);
+                });
+            });
+        }
+};
+
+// Line-by-line CSV loading with a plantTree(name, color) per row vs the batched bulk ingest
+void runCsvIngestBenchmark() {
+    using Clock = std::chrono::steady_clock;
+    const size_t rows = 2000000;
+    const char* names[] = {"Oak", "Pine", "Birch", "Maple"};
+    const char* colors[] = {"Green", "Brown"};
+    const std::string path = (std::filesystem::temp_directory_path() / "forest_benchmark.csv").string();
+    {
+        std::ofstream out(path, std::ios::binary);
+        std::string text = "x,y,name,color\n";
+        for (size_t i = 0; i < rows; ++i) {
+            text += std::to_string(i % 4000) + ',' + std::to_string(i / 4000) + ',' + names[(i / 64) % 4] + ',' + colors[(i / 256) % 2] + '\n';
+        }
+        out << text;
+    }
+    double megabytes = std::filesystem::file_size(path) / (1024.0 * 1024.0);
+
+    auto start = Clock::now();
+    CompactForest naive;
+    {
+        std::ifstream in(path);
+        std::string line, x, y, name, color;
+        std::getline(in, line);  // header
+        while (std::getline(in, line)) {
+            std::istringstream fields(line);
+            std::getline(fields, x, ',');
+            std::getline(fields, y, ',');
+            std::getline(fields, name, ',');
+            std::getline(fields, color);
+            naive.plantTree(std::stoi(x), std::stoi(y), name, color);
+        }
+    }
+    double naiveSec = std::chrono::duration<double>(Clock::now() - start).count();
+
+    start = Clock::now();
+    CompactForest bulk;
+    size_t planted = bulk.plantFromCsv(path);
+    double bulkSec = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::cout << "\nCSV ingest (" << rows << " rows, " << static_cast<int>(megabytes) << " MB):\n";
+    std::cout << "getline + plantTree: " << static_cast<long long>(naive.size() / naiveSec) << " rows/sec, "
+              << static_cast<int>(megabytes / naiveSec) << " MB/s\n";
+    std::cout << "plantFromCsv:        " << static_cast<long long>(planted / bulkSec) << " rows/sec, "
+              << static_cast<int>(megabytes / bulkSec) << " MB/s\n";
+    std::filesystem::remove(path);
+}
+
+// Rebuilding a big forest tree by tree vs mapping its snapshot
+void runSnapshotBenchmark() {
+    using Clock = std::chrono::steady_clock;
+    const size_t treeCount = 2000000;
+    const char* names[] = {"Oak", "Pine", "Birch", "Maple"};
+    const std::string path = (std::filesystem::temp_directory_path() / "forest_benchmark.snapshot").string();
+
+    auto start = Clock::now();
+    CompactForest big;
+    big.reserve(treeCount);
+    for (size_t i = 0; i < treeCount; ++i) {
+        big.plantTree(static_cast<int>(i % 4000), static_cast<int>(i / 4000), names[i % 4], "Green");
+    }
+    double rebuildMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    big.saveSnapshot(path);
+
+    start = Clock::now();
+    MappedForest mapped(path);
+    double loadMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    long long checksum = 0, expected = 0;
+    big.forEach([&](int x, int y, CompactForest::TypeId16 type) { expected += x + 3LL * y + type; });
+    mapped.forEach([&](int x, int y, TreeTypeId type) { checksum += x + 3LL * y + type; });
+
+    std::cout << "\nForest snapshot (" << treeCount << " trees, "
+              << std::filesystem::file_size(path) / (1024 * 1024) << " MB):\n";
+    std::cout << "Rebuild with plantTree: " << rebuildMs << " ms\n";
+    std::cout << "Map snapshot:           " << loadMs << " ms (" << mapped.size() << " trees, "
+              << (checksum == expected ? "contents match" : "contents DIFFER") << ")\n";
+    std::filesystem::remove(path);
+}
+
+// Viewport culling on a large forest: full scan vs grid query, same visible set
+void runViewportBenchmark() {
+    using Clock = std::chrono::steady_clock;
+    const size_t treeCount = 2000000;
+    const int worldSize = 100000;
+    CompactForest big;
+    big.reserve(treeCount);
+    big.enableSpatialIndex(256);
+    TreeTypeId types[] = {TreeTypeFactory::getTypeId("Oak", "Green"), TreeTypeFactory::getTypeId("Pine", "Green")};
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> pos(0, worldSize - 1);
+    for (size_t i = 0; i < treeCount; ++i) big.plantTree(pos(rng), pos(rng), types[i & 1]);
+
+    Viewport view{50000, 50000, 51000, 50800};
+    size_t scanned = 0, indexed = 0;
+    auto start = Clock::now();
+    big.forEach([&](int x, int y, CompactForest::TypeId16) { scanned += view.contains(x, y); });
+    auto scanUs = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    start = Clock::now();
+    big.forEachVisible(view, [&](int, int, CompactForest::TypeId16) { ++indexed; });
+    auto gridUs = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    std::cout << "\nViewport culling over " << treeCount << " trees:\n";
+    std::cout << "Full scan:  " << scanned << " visible in " << scanUs << " us\n";
+    std::cout << "Grid query: " << indexed << " visible in " << gridUs << " us\n";
+}
+
+// Discards everything written to it, so the benchmark measures formatting and stream overhead
+class NullBuffer : public std::streambuf {
+    protected:
+        int_type overflow(int_type c) override { return traits_type::not_eof(c); }
+        std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+// Per-tree std::cout rendering vs the chunked parallel pipeline, both into a discarding sink
+void runRenderBenchmark() {
+    using Clock = std::chrono::steady_clock;
+    const size_t treeCount = 1000000;
+    CompactForest big;
+    big.reserve(treeCount);
+    TreeTypeId types[] = {TreeTypeFactory::getTypeId("Oak", "Green"), TreeTypeFactory::getTypeId("Pine", "Green")};
+    for (size_t i = 0; i < treeCount; ++i) {
+        big.plantTree(static_cast<int>(i % 5000), static_cast<int>(i / 5000), types[i & 1]);
+    }
+    NullBuffer sink;
+    std::ostream nullOut(&sink);
+
+    auto start = Clock::now();
+    std::streambuf* previous = std::cout.rdbuf(&sink);
+    big.render();
+    std::cout.rdbuf(previous);
+    double serialSec = std::chrono::duration<double>(Clock::now() - start).count();
+
+    start = Clock::now();
+    big.renderParallel(nullOut);
+    double parallelSec = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::cout << "\nRendering " << treeCount << " trees (" << std::max(1u, std::thread::hardware_concurrency())
+              << " hardware threads):\n";
+    std::cout << "Per-tree cout:     " << static_cast<long long>(treeCount / serialSec) << " trees/sec\n";
+    std::cout << "Chunked pipeline:  " << static_cast<long long>(treeCount / parallelSec) << " trees/sec\n";
+}
+
+// Loader threads planting by (name, color) into their own CompactForest shards: every lookup
+// hits the lock-free snapshot, so throughput should grow with the thread count
+void runParallelPlantBenchmark() {
+    using Clock = std::chrono::steady_clock;
+    const size_t treeCount = 2000000;
+    const char* names[] = {"Oak", "Pine", "Birch", "Maple"};
+    const char* colors[] = {"Green", "Brown"};
+    unsigned maxThreads = std::max(4u, std::thread::hardware_concurrency());
+    std::cout << "\nParallel plantTree by name (" << treeCount << " trees, "
+              << std::thread::hardware_concurrency() << " hardware threads):\n";
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        std::vector<CompactForest> shards(threads);
+        auto start = Clock::now();
+        std::vector<std::thread> loaders;
+        for (unsigned t = 0; t < threads; ++t) {
+            loaders.emplace_back([&, t] {
+                CompactForest& shard = shards[t];
+                size_t begin = treeCount * t / threads, end = treeCount * (t + 1) / threads;
+                shard.reserve(end - begin);
+                for (size_t i = begin; i < end; ++i) {
+                    shard.plantTree(static_cast<int>(i % 1000), static_cast<int>(i / 1000), names[i % 4], colors[(i / 4) % 2]);
+                }
+            });
+        }
+        for (auto& loader : loaders) loader.join();
+        double sec = std::chrono::duration<double>(Clock::now() - start).count();
+        std::cout << threads << " thread(s): " << static_cast<long long>(treeCount / sec) << " trees/sec\n";
+    }
+}
+
 int main() {
     Forest forest;
     
@@ -109,8 +1074,58 @@ int main() {
     forest.plantTree(90, 100, "Oak", "Brown");   // Creates new Oak-Brown flyweight 
     forest.plantTree(110, 120, "Oak", "Green");  // Reuses Oak-Green flyweight again
     
+    // Interned once, then planted by id with no lookup at all
+    TreeTypeId birch = TreeTypeFactory::getTypeId("Birch", "White");
+    for (int i = 0; i < 3; ++i) {
+        forest.plantTree(130 + 20 * i, 140, birch);
+    }
+
     forest.render();
     forest.showStats();
+
+    // Same trees in the structure-of-arrays modes
+    CompactForest columns;
+    CompactForest quantized(CompactForest::Quantization{0, 0, 10});
+    for (CompactForest* f : {&columns, &quantized}) {
+        f->reserve(9);
+        f->plantTree(10, 20, "Oak", "Green");
+        f->plantTree(30, 40, "Pine", "Green");
+        f->plantTree(50, 60, "Oak", "Green");
+        f->plantTree(70, 80, "Pine", "Green");
+        f->plantTree(90, 100, "Oak", "Brown");
+        f->plantTree(110, 120, "Oak", "Green");
+        for (int i = 0; i < 3; ++i) f->plantTree(130 + 20 * i, 140, birch);
+    }
+    quantized.render();
+    columns.showStats();
+    quantized.showStats();
+    ForestBounds b = quantized.bounds();
+    std::cout << "Bounds: (" << b.minX << ", " << b.minY << ") - (" << b.maxX << ", " << b.maxY << ")\n";
+
+    columns.enableSpatialIndex(50);
+    columns.plantTree(60, 70, "Pine", "Green");  // indexed incrementally
+    columns.render(Viewport{40, 50, 100, 100});
+    const std::string snapshotPath = (std::filesystem::temp_directory_path() / "forest_demo.snapshot").string();
+    quantized.saveSnapshot(snapshotPath);
+    {
+        MappedForest mapped(snapshotPath);
+        mapped.render();
+    }
+    std::filesystem::remove(snapshotPath);
+
+    std::istringstream csv("x,y,name,color\n200,10,Oak,Green\n220,30,Willow,Yellow\n240,50,Willow,Yellow\n");
+    CompactForest imported;
+    size_t importedCount = imported.plantFromCsv(csv);
+    std::cout << "\nImported " << importedCount << " trees from CSV";
+    imported.render();
+
+    std::cout << "\nBuffered rendering:\n";
+    forest.renderParallel(std::cout, 4);
+    runViewportBenchmark();
+    runRenderBenchmark();
+    runParallelPlantBenchmark();
+    runSnapshotBenchmark();
+    runCsvIngestBenchmark();
     
     return 0;
 }
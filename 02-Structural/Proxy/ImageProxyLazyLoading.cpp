@@ -5,6 +5,31 @@
 #include <vector>
 #include <chrono>
 #include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <algorithm>
+#include <list>
+#include <span>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <filesystem>
+#include <fstream>
+// POSIX, for the memory-mapped loader; other platforms read the file into memory instead
+#if defined(__unix__) || defined(__APPLE__)
+#define IMAGE_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define IMAGE_HAS_MMAP 0
+#endif
 //subject interface defines common operations
 //Defines the common interface that both Real Subject and Proxy implement
 class Image{
@@ -14,54 +39,432 @@ class Image{
         virtual void load() = 0;
         virtual std::string getInfo() const = 0;
 };
+// Read-only memory mapping of a whole file (POSIX). The bytes are exposed as a span straight
+// from the page cache: nothing is copied, and pages are faulted in only when touched.
+// Without mmap the file is read into an owned buffer once; bytes() looks the same to callers.
+class MappedFile {
+    public:
+        enum class AccessHint { Normal, Sequential, WillNeed };
+        static constexpr bool kZeroCopy = IMAGE_HAS_MMAP;
+    private:
+        const std::byte* data_ = nullptr;
+        size_t size_ = 0;
+#if !IMAGE_HAS_MMAP
+        std::vector<std::byte> owned_;
+#endif
+    public:
+        MappedFile() = default;
+#if IMAGE_HAS_MMAP
+        MappedFile(const std::string& path, AccessHint hint) {
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) throw std::runtime_error("Cannot open " + path);
+            struct stat st{};
+            if (fstat(fd, &st) != 0) {
+                ::close(fd);
+                throw std::runtime_error("Cannot stat " + path);
+            }
+            size_ = static_cast<size_t>(st.st_size);
+            if (size_ > 0) {
+                void* p = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p == MAP_FAILED) {
+                    ::close(fd);
+                    throw std::runtime_error("Cannot map " + path);
+                }
+                data_ = static_cast<const std::byte*>(p);
+                // Sequential: aggressive read-ahead, pages dropped behind the reader.
+                // WillNeed: start reading the whole file in now, before the first access.
+                if (hint == AccessHint::Sequential) madvise(p, size_, MADV_SEQUENTIAL);
+                if (hint == AccessHint::WillNeed) madvise(p, size_, MADV_WILLNEED);
+            }
+            ::close(fd);  // the mapping stays valid after the descriptor is closed
+        }
+        ~MappedFile() { reset(); }
+        MappedFile(MappedFile&& other) noexcept
+            : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+        MappedFile& operator=(MappedFile&& other) noexcept {
+            if (this != &other) {
+                reset();
+                data_ = std::exchange(other.data_, nullptr);
+                size_ = std::exchange(other.size_, 0);
+            }
+            return *this;
+        }
+
+        void reset() {
+            if (data_) munmap(const_cast<std::byte*>(data_), size_);
+            data_ = nullptr;
+            size_ = 0;
+        }
+#else
+        MappedFile(const std::string& path, AccessHint) {
+            std::ifstream in(path, std::ios::binary);
+            if (!in) throw std::runtime_error("Cannot open " + path);
+            owned_.resize(static_cast<size_t>(std::filesystem::file_size(path)));
+            if (!in.read(reinterpret_cast<char*>(owned_.data()), static_cast<std::streamsize>(owned_.size()))) {
+                throw std::runtime_error("Cannot read " + path);
+            }
+            data_ = owned_.data();
+            size_ = owned_.size();
+        }
+        // Moving a vector keeps its heap buffer, so data_ stays valid in the new owner
+        MappedFile(MappedFile&& other) noexcept
+            : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)),
+              owned_(std::move(other.owned_)) {}
+        MappedFile& operator=(MappedFile&& other) noexcept {
+            if (this != &other) {
+                data_ = std::exchange(other.data_, nullptr);
+                size_ = std::exchange(other.size_, 0);
+                owned_ = std::move(other.owned_);
+            }
+            return *this;
+        }
+
+        void reset() {
+            owned_ = {};
+            data_ = nullptr;
+            size_ = 0;
+        }
+#endif
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        std::span<const std::byte> bytes() const { return {data_, size_}; }
+};
+
+// Loaded image bytes plus a reference that keeps them alive. An unload() (e.g. by the residency
+// manager on another thread) only drops the image's own reference, so the span stays valid for
+// as long as the caller holds this; the memory is released when the last holder lets go.
+struct ImageBytes {
+    std::shared_ptr<const void> owner;
+    std::span<const std::byte> data;
+};
+
+class ImageResidencyManager;
+
 // real subject; the actual heavy object
-class RealImage : public Image{
+class RealImage : public Image, public std::enable_shared_from_this<RealImage>{
     private:
+        static constexpr size_t kDecodedBytes = 1 << 20;  // simulated decoded bitmap per image
+        static constexpr char kDataPrefix[] = "Binary Data for : ";
         std::string fileName_;
         std::string imageData_;
-        bool isLoaded_;
+        std::shared_ptr<const std::vector<unsigned char>> pixels_;  // shared with ImageBytes holders
+        // Real files on disk are mapped instead of simulated
+        bool onDisk_;
+        size_t fileBytes_ = 0;
+        std::shared_ptr<const MappedFile> mapped_;  // shared with ImageBytes holders
+        MappedFile::AccessHint accessHint_ = MappedFile::AccessHint::Sequential;
+        std::atomic<bool> isLoaded_;  // read by display() while a pool worker may be loading
+        mutable std::mutex loadMutex_;  // at most one load, even if sync and async callers race
+        ImageResidencyManager* residency_;  // optional memory budget; must outlive the image
+
+        // Caller holds loadMutex_; returns true if this call did the load
+        bool loadLocked(){
+            if (isLoaded_) return false;
+            std::cout << "Loading image from Disk : " << fileName_ << std::endl;
+            if (onDisk_) {
+                mapped_ = std::make_shared<const MappedFile>(fileName_, accessHint_);
+                imageData_ = "Mapped " + std::to_string(mapped_->bytes().size()) + " bytes of " + fileName_;
+                isLoaded_ = true;
+                std::cout << "Image mapped successfully: " << fileName_ << std::endl;
+                return true;
+            }
+            // No such file: simulate Expensive loading operation
+            std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+            imageData_ = kDataPrefix + fileName_;
+            pixels_ = std::make_shared<const std::vector<unsigned char>>(kDecodedBytes, 0);
+            isLoaded_ = true;
+            std::cout << "Image loaded successfully: " << fileName_ << std::endl;
+            return true;
+        }
+        // Residency callbacks run without loadMutex_ held: the manager may unload other images
+        void reportLoaded();
+        void reportDisplayed();
     public:
-        explicit RealImage(const std::string &filename): Image(), fileName_(filename), isLoaded_(false){
+        explicit RealImage(const std::string &filename, ImageResidencyManager* residency = nullptr)
+            : Image(), fileName_(filename), isLoaded_(false), residency_(residency){
+            std::error_code ec;
+            onDisk_ = std::filesystem::is_regular_file(fileName_, ec);
+            if (onDisk_) fileBytes_ = std::filesystem::file_size(fileName_, ec);
             std::cout << "Real image created for : " << fileName_ << std::endl;
         }
+        ~RealImage() override;
         void load() override{
-            if (!isLoaded_){
-                std::cout << "Loading image from Disk : " << fileName_ << std::endl;
-                // Simulate Expensive loading operation
-                std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-                imageData_ = "Binary Data for : " + fileName_;
-                isLoaded_ = true;
-                std::cout << "Image loaded successfully: " << fileName_ << std::endl;
+            bool loaded;
+            {
+                std::lock_guard<std::mutex> lock(loadMutex_);
+                loaded = loadLocked();
             }
+            if (loaded) reportLoaded();
         }
         void display() override{
-            if (!isLoaded_){
-                load();
+            bool loaded;
+            {
+                // Held while printing so a concurrent unload() cannot clear the data mid-display
+                std::lock_guard<std::mutex> lock(loadMutex_);
+                loaded = loadLocked();
+                std::cout << "Displaying image: " << fileName_ << " [" << imageData_ << "]" << std::endl;
+            }
+            if (loaded) {
+                reportLoaded();
+            } else {
+                reportDisplayed();
             }
-            std::cout << "Displaying image: " << fileName_ << " [" << imageData_ << "]" << std::endl;
         }
+        // Drops the payload; the next load()/display() reads it from disk again
+        void unload(){
+            std::lock_guard<std::mutex> lock(loadMutex_);
+            if (!isLoaded_) return;
+            imageData_.clear();
+            imageData_.shrink_to_fit();
+            pixels_.reset();  // freed now unless an ImageBytes still holds it
+            mapped_.reset();
+            isLoaded_ = false;
+            std::cout << "Image unloaded to free memory: " << fileName_ << std::endl;
+        }
+        // Known before loading, so the manager can account for it up front
+        size_t residentBytes() const {
+            return onDisk_ ? fileBytes_ : kDecodedBytes + sizeof(kDataPrefix) - 1 + fileName_.size();
+        }
+        void setAccessHint(MappedFile::AccessHint hint) { accessHint_ = hint; }
+        // Read-only view of the loaded bytes (the mapping for real files); empty until loaded.
+        // The handle keeps them alive even if the image is unloaded meanwhile.
+        ImageBytes bytes() const {
+            std::lock_guard<std::mutex> lock(loadMutex_);
+            if (mapped_) return ImageBytes{mapped_, mapped_->bytes()};
+            if (pixels_) return ImageBytes{pixels_, std::as_bytes(std::span<const unsigned char>(*pixels_))};
+            return ImageBytes{};
+        }
+        bool isLoaded() const { return isLoaded_; }
         std::string getInfo() const override{
             return "Realimage : " + fileName_ + "(Loaded Image : " + (isLoaded_? "Yes" : "No") + ")";
         }
 
 };
 
+struct ResidencyStats {
+    size_t residentBytes = 0;
+    size_t peakBytes = 0;
+    size_t loads = 0;
+    size_t evictions = 0;
+};
+
+// Shared memory budget for loaded RealImage payloads across all proxies.
+// Images are kept in least-recently-displayed order; when a load pushes the total over the
+// budget the coldest images are unloaded (their proxies reload them on demand).
+// The newest image is always kept, even if it alone exceeds the budget.
+class ImageResidencyManager {
+    private:
+        struct Resident {
+            std::weak_ptr<RealImage> image;
+            const RealImage* raw;  // index_ key; valid to compare even after the image is gone
+            size_t bytes;
+        };
+        size_t budgetBytes_;
+        std::list<Resident> lru_;  // front = most recently displayed
+        std::unordered_map<const RealImage*, std::list<Resident>::iterator> index_;
+        ResidencyStats stats_;
+        mutable std::mutex mutex_;
+    public:
+        explicit ImageResidencyManager(size_t budgetBytes) : budgetBytes_(budgetBytes) {}
+
+        void onLoaded(RealImage& image) {
+            std::vector<std::shared_ptr<RealImage>> victims;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto found = index_.find(&image);
+                if (found != index_.end()) {
+                    lru_.splice(lru_.begin(), lru_, found->second);
+                } else {
+                    lru_.push_front(Resident{image.weak_from_this(), &image, image.residentBytes()});
+                    index_[&image] = lru_.begin();
+                    stats_.residentBytes += image.residentBytes();
+                }
+                ++stats_.loads;
+                while (stats_.residentBytes > budgetBytes_ && lru_.size() > 1) {
+                    Resident& coldest = lru_.back();
+                    stats_.residentBytes -= coldest.bytes;
+                    // Unindex even if the image is already dying: its ~RealImage -> forget()
+                    // must then find nothing, rather than a dangling iterator and a second subtraction
+                    index_.erase(coldest.raw);
+                    if (auto victim = coldest.image.lock()) {
+                        victims.push_back(std::move(victim));
+                    }
+                    lru_.pop_back();
+                    ++stats_.evictions;
+                }
+                stats_.peakBytes = std::max(stats_.peakBytes, stats_.residentBytes);
+            }
+            for (auto& victim : victims) victim->unload();  // outside our lock
+        }
+
+        void onDisplayed(const RealImage& image) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto found = index_.find(&image);
+            if (found != index_.end()) lru_.splice(lru_.begin(), lru_, found->second);
+        }
+
+        void forget(const RealImage* image) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto found = index_.find(image);
+            if (found == index_.end()) return;
+            stats_.residentBytes -= found->second->bytes;
+            lru_.erase(found->second);
+            index_.erase(found);
+        }
+
+        ResidencyStats getStats() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return stats_;
+        }
+};
+
+void RealImage::reportLoaded() {
+    if (residency_) residency_->onLoaded(*this);
+}
+void RealImage::reportDisplayed() {
+    if (residency_) residency_->onDisplayed(*this);
+}
+RealImage::~RealImage() {
+    if (residency_) residency_->forget(this);
+}
+
+struct RegistryStats {
+    size_t created = 0;  // RealImage instances constructed
+    size_t shared = 0;   // requests answered with an existing instance
+    size_t pruned = 0;   // expired handles dropped
+};
+
+// Interning registry: proxies for the same filename share one RealImage.
+// The registry only keeps weak handles, so an image is destroyed (and its memory freed) as soon
+// as the last proxy holding it goes away. Because every sharer gets the same instance,
+// concurrent first loads are coalesced by RealImage's own load lock: one disk read, one copy.
+class ImageRegistry {
+    private:
+        static constexpr size_t kMinSweepSize = 64;
+        std::unordered_map<std::string, std::weak_ptr<RealImage>> images_;
+        RegistryStats stats_;
+        size_t sweepAt_ = kMinSweepSize;  // map size that triggers the next sweep of expired handles
+        mutable std::mutex mutex_;
+
+        size_t pruneLocked() {
+            size_t removed = std::erase_if(images_, [](const auto& entry) { return entry.second.expired(); });
+            stats_.pruned += removed;
+            // Doubling the threshold over what survived keeps sweeps amortized O(1) per acquire
+            // and the map within about twice the live images
+            sweepAt_ = std::max(kMinSweepSize, 2 * images_.size());
+            return removed;
+        }
+    public:
+        std::shared_ptr<RealImage> acquire(const std::string& filename, ImageResidencyManager* residency = nullptr) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (images_.size() >= sweepAt_ && !images_.count(filename)) pruneLocked();
+            auto& handle = images_[filename];  // an expired handle for this name is simply reused
+            if (auto existing = handle.lock()) {
+                ++stats_.shared;
+                return existing;
+            }
+            auto image = std::make_shared<RealImage>(filename, residency);
+            handle = image;
+            ++stats_.created;
+            return image;
+        }
+
+        // Drops handles whose images are gone; acquire also does this as the map grows
+        size_t prune() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return pruneLocked();
+        }
+
+        size_t size() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return images_.size();
+        }
+
+        RegistryStats getStats() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return stats_;
+        }
+};
+
+// Bounded I/O pool: a fixed number of workers drain a shared queue of load jobs,
+// so any number of proxies can load concurrently without one thread per image.
+class IoThreadPool {
+    private:
+        std::vector<std::thread> workers_;
+        std::deque<std::function<void()>> jobs_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        bool stopping_ = false;
+
+        void workerLoop() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (true) {
+                cv_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+                if (jobs_.empty()) return;  // stopping and drained
+                auto job = std::move(jobs_.front());
+                jobs_.pop_front();
+                lock.unlock();
+                // A throwing job must not take the worker (and with it the process) down
+                try {
+                    job();
+                } catch (const std::exception& e) {
+                    std::cout << "I/O job failed: " << e.what() << std::endl;
+                }
+                lock.lock();
+            }
+        }
+    public:
+        explicit IoThreadPool(size_t workers) {
+            for (size_t i = 0; i < std::max<size_t>(1, workers); ++i) {
+                workers_.emplace_back(&IoThreadPool::workerLoop, this);
+            }
+        }
+        // Pending jobs are finished before the workers exit
+        ~IoThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopping_ = true;
+            }
+            cv_.notify_all();
+            for (auto& w : workers_) w.join();
+        }
+        IoThreadPool(const IoThreadPool&) = delete;
+        IoThreadPool& operator=(const IoThreadPool&) = delete;
+
+        void submit(std::function<void()> job) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                jobs_.push_back(std::move(job));
+            }
+            cv_.notify_one();
+        }
+};
+
 // Virtual Proxy - controls access and lazy loading
 class ImageProxy : public Image {
 private:
     std::string filename_;
     //mutable: Allows lazy loading in const methods (logical constness)
-    mutable std::unique_ptr<RealImage> realImage_;  // mutable for lazy loading in const methods
+    // shared_ptr so an in-flight pool job keeps the image alive if the proxy goes away first
+    mutable std::shared_ptr<RealImage> realImage_;  // mutable for lazy loading in const methods
+    IoThreadPool* pool_ = nullptr;        // async mode when set; not owned
+    ImageResidencyManager* residency_ = nullptr;  // shared memory budget when set; not owned
+    ImageRegistry* registry_ = nullptr;  // share one RealImage per filename when set; not owned
+    std::shared_future<void> pendingLoad_;
+    std::function<void(const ImageProxy&)> accessListener_;  // e.g. a PrefetchController
     RealImage* getRealImage() const {
         if (!realImage_) {
             std::cout << "Proxy: Creating real image on demand..." << std::endl;
-            realImage_ = std::make_unique<RealImage>(filename_);
+            realImage_ = registry_ ? registry_->acquire(filename_, residency_)
+                                   : std::make_shared<RealImage>(filename_, residency_);
         }
         std::cout << "Proxy: Real image address, it will return the same heavy object and create only once " << &realImage_ << std::endl;
         return realImage_.get();
     }
 public:
-    explicit ImageProxy(const std::string& filename) : filename_(filename) {
+    explicit ImageProxy(const std::string& filename, IoThreadPool* pool = nullptr,
+                        ImageResidencyManager* residency = nullptr, ImageRegistry* registry = nullptr)
+        : filename_(filename), pool_(pool), residency_(residency), registry_(registry) {
         std::cout << "ImageProxy created for: " << filename_ << std::endl;
     }
 
@@ -69,8 +472,59 @@ public:
         getRealImage()->load();
     }
 
+    // Starts loading on the pool (or inline without one) and returns a future that is ready
+    // once the data is in memory; onReady runs on the worker thread after the load.
+    // Repeated calls return the same future, unless the image was unloaded since it completed.
+    std::shared_future<void> loadAsync(std::function<void(const std::string&)> onReady = {}) {
+        if (pendingLoad_.valid()) {
+            bool finished = pendingLoad_.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+            if (!finished || isReady()) return pendingLoad_;
+        }
+        getRealImage();
+        std::shared_ptr<RealImage> image = realImage_;
+        auto task = std::make_shared<std::packaged_task<void()>>(
+            [image, onReady, name = filename_] {
+                image->load();
+                if (onReady) onReady(name);
+            });
+        pendingLoad_ = task->get_future().share();
+        if (pool_) {
+            pool_->submit([task] { (*task)(); });
+        } else {
+            (*task)();
+        }
+        return pendingLoad_;
+    }
+
+    // Ready while the data is in memory, whoever loaded it (loadAsync, load or a prefetch);
+    // false again once the residency manager has unloaded it
+    bool isReady() const {
+        return realImage_ && realImage_->isLoaded();
+    }
+
+    // The real image, created on demand but not loaded; lets helpers such as the prefetcher
+    // load it on a worker thread while the proxy stays the only place that creates it
+    std::shared_ptr<RealImage> realImageHandle() {
+        getRealImage();
+        return realImage_;
+    }
+
+    // Called at the start of every display(), before the proxy decides how to show the image
+    void setAccessListener(std::function<void(const ImageProxy&)> listener) {
+        accessListener_ = std::move(listener);
+    }
+
+    const std::string& getFilename() const { return filename_; }
+
     void display() override {
+        if (accessListener_) accessListener_(*this);
         std::cout << "Proxy: Delegating display request..." << std::endl;
+        if (pool_ && !isReady()) {
+            // Async mode: never block the caller, show a placeholder until the data arrives
+            loadAsync();
+            std::cout << "Displaying placeholder for: " << filename_ << " (loading...)" << std::endl;
+            return;
+        }
         getRealImage()->display();
     }
 
@@ -83,6 +537,159 @@ public:
    
 };
 
+struct PrefetchStats {
+    size_t issued = 0;     // prefetch jobs submitted to the pool
+    size_t hits = 0;       // displayed after its prefetch had finished (no stall)
+    size_t late = 0;       // displayed while its prefetch was still queued or loading
+    size_t cancelled = 0;  // dropped from the queue after leaving the window, never loaded
+    size_t wasted = 0;     // loaded by prefetch but not displayed (so far)
+    size_t failed = 0;     // prefetch load threw (e.g. the file could not be mapped)
+};
+
+// Predictive prefetch for an ordered gallery of proxies.
+// The controller listens to display() calls, infers the scroll direction from the last two
+// accesses and warms the next K images in that direction on the pool. Prefetches still queued
+// when they fall out of the window are cancelled; ones already loading are allowed to finish.
+class PrefetchController {
+private:
+    struct Ticket {
+        std::atomic<bool> cancelled{false};
+        std::atomic<bool> started{false};
+        std::atomic<bool> done{false};
+        std::atomic<bool> failed{false};  // set before done
+    };
+
+    IoThreadPool& pool_;
+    std::vector<ImageProxy*> gallery_;
+    std::unordered_map<const ImageProxy*, size_t> positions_;
+    std::unordered_map<size_t, std::shared_ptr<Ticket>> tickets_;  // by gallery index
+    std::vector<bool> displayed_;
+    size_t lookahead_;
+    size_t lastIndex_ = 0;
+    bool hasLast_ = false;
+    PrefetchStats stats_;
+
+    void onAccess(const ImageProxy& proxy) {
+        auto pos = positions_.find(&proxy);
+        if (pos == positions_.end()) return;
+        size_t index = pos->second;
+
+        auto t = tickets_.find(index);
+        if (t != tickets_.end() && !displayed_[index]) {
+            if (t->second->done && t->second->failed) {
+                ++stats_.failed;  // display() retries the load on the caller's thread
+            } else if (t->second->done) {
+                ++stats_.hits;
+            } else {
+                ++stats_.late;
+            }
+        }
+        displayed_[index] = true;
+
+        bool forward = !hasLast_ || index >= lastIndex_;
+        lastIndex_ = index;
+        hasLast_ = true;
+
+        // Window = next K positions in the scroll direction
+        std::vector<size_t> window;
+        for (size_t step = 1; step <= lookahead_; ++step) {
+            if (forward && index + step < gallery_.size()) window.push_back(index + step);
+            if (!forward && index >= step) window.push_back(index - step);
+        }
+
+        for (auto it = tickets_.begin(); it != tickets_.end();) {
+            bool inWindow = std::find(window.begin(), window.end(), it->first) != window.end();
+            if (!inWindow && !it->second->started) {
+                it->second->cancelled = true;
+                ++stats_.cancelled;
+                it = tickets_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        for (size_t target : window) {
+            if (tickets_.count(target) || displayed_[target] || gallery_[target]->isReady()) continue;
+            auto ticket = std::make_shared<Ticket>();
+            auto image = gallery_[target]->realImageHandle();
+            tickets_[target] = ticket;
+            ++stats_.issued;
+            pool_.submit([ticket, image] {
+                if (ticket->cancelled) return;
+                ticket->started = true;
+                try {
+                    image->load();
+                } catch (const std::exception& e) {
+                    std::cout << "Prefetch failed: " << e.what() << std::endl;
+                    ticket->failed = true;
+                }
+                ticket->done = true;
+            });
+        }
+    }
+
+public:
+    PrefetchController(IoThreadPool& pool, std::vector<ImageProxy*> gallery, size_t lookahead)
+        : pool_(pool), gallery_(std::move(gallery)), displayed_(gallery_.size(), false), lookahead_(lookahead) {
+        for (size_t i = 0; i < gallery_.size(); ++i) {
+            positions_[gallery_[i]] = i;
+            gallery_[i]->setAccessListener([this](const ImageProxy& proxy) { onAccess(proxy); });
+        }
+    }
+
+    ~PrefetchController() {
+        for (auto* proxy : gallery_) proxy->setAccessListener(nullptr);
+        for (auto& [index, ticket] : tickets_) ticket->cancelled = true;
+    }
+
+    PrefetchController(const PrefetchController&) = delete;
+    PrefetchController& operator=(const PrefetchController&) = delete;
+
+    PrefetchStats getStats() const {
+        PrefetchStats s = stats_;
+        for (const auto& [index, ticket] : tickets_) {
+            if (ticket->done && !ticket->failed && !displayed_[index]) ++s.wasted;
+        }
+        return s;
+    }
+};
+
+// Loads the same large file twice per round: read() into a heap buffer versus mmap + span.
+// Both then touch every byte (checksum), so the comparison includes actually using the data.
+void runFileLoadBenchmark(const std::string& path) {
+    using Clock = std::chrono::steady_clock;
+    auto ms = [](Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+    auto checksum = [](std::span<const std::byte> bytes) {
+        uint64_t sum = 0;
+        for (std::byte b : bytes) sum += static_cast<uint8_t>(b);
+        return sum;
+    };
+    const int rounds = 3;
+    double readMs = 0, mapMs = 0;
+    uint64_t readSum = 0, mapSum = 0;
+    for (int r = 0; r < rounds; ++r) {
+        auto start = Clock::now();
+        {
+            std::ifstream in(path, std::ios::binary);
+            std::vector<std::byte> buffer(static_cast<size_t>(std::filesystem::file_size(path)));
+            in.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+            readSum = checksum(buffer);
+        }
+        readMs += ms(Clock::now() - start);
+
+        start = Clock::now();
+        {
+            MappedFile mapped(path, MappedFile::AccessHint::Sequential);
+            mapSum = checksum(mapped.bytes());
+        }
+        mapMs += ms(Clock::now() - start);
+    }
+    std::cout << "read() into buffer: " << readMs / rounds << " ms/load" << std::endl;
+    std::cout << (MappedFile::kZeroCopy ? "mmap + span:        " : "MappedFile (no mmap): ") << mapMs / rounds
+              << (MappedFile::kZeroCopy ? " ms/load (no copy, no heap buffer)" : " ms/load (read fallback)") << std::endl;
+    if (readSum != mapSum) std::cout << "checksum mismatch!" << std::endl;
+}
+
 int main() {
     std::cout << "=== Proxy Pattern Examples ===" << std::endl;
 
@@ -104,5 +711,102 @@ int main() {
     //ImageProxy only creates/loads the RealImage when display() is called
     std::cout << "\nDisplaying first image again (already loaded):" << std::endl;
     images[0]->display();
+
+    // 2. Async loading on a bounded I/O pool
+    std::cout << "\n2. Async loading, 6 images on a 3-worker pool:" << std::endl;
+    IoThreadPool pool(3);
+    std::vector<std::unique_ptr<ImageProxy>> gallery;
+    for (int i = 1; i <= 6; ++i) {
+        gallery.push_back(std::make_unique<ImageProxy>("gallery" + std::to_string(i) + ".jpg", &pool));
+    }
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::shared_future<void>> loads;
+    for (auto& img : gallery) {
+        loads.push_back(img->loadAsync([](const std::string& name) {
+            std::cout << "Ready callback: " << name << std::endl;
+        }));
+    }
+    gallery[0]->display();  // returns immediately with a placeholder
+    for (auto& f : loads) f.wait();
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    std::cout << "All 6 images loaded in " << elapsed << " ms (sequential would take ~6000 ms)" << std::endl;
+    gallery[0]->display();  // real data now
+
+    // 3. Predictive prefetch while scrolling (2 workers, look ahead K = 2)
+    std::cout << "\n3. Predictive prefetch while scrolling:" << std::endl;
+    IoThreadPool prefetchPool(2);
+    std::vector<std::unique_ptr<ImageProxy>> album;
+    std::vector<ImageProxy*> order;
+    for (int i = 1; i <= 8; ++i) {
+        album.push_back(std::make_unique<ImageProxy>("album" + std::to_string(i) + ".jpg"));
+        order.push_back(album.back().get());
+    }
+    PrefetchController prefetcher(prefetchPool, order, 2);
+    for (size_t i : {0, 1, 2, 3, 4, 2}) {  // scroll forward, then jump back
+        auto shown = std::chrono::steady_clock::now();
+        album[i]->display();
+        auto stall = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - shown).count();
+        std::cout << "Showed " << album[i]->getFilename() << " after " << stall << " ms" << std::endl;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1200));  // user looks at the image
+    }
+    PrefetchStats ps = prefetcher.getStats();
+    std::cout << "Prefetch stats: issued=" << ps.issued << " hits=" << ps.hits << " late=" << ps.late
+              << " cancelled=" << ps.cancelled << " wasted=" << ps.wasted << " failed=" << ps.failed << std::endl;
+
+    // 4. Memory budget shared by all proxies: room for 2 decoded images
+    std::cout << "\n4. Memory-budgeted residency (budget = 2 images):" << std::endl;
+    ImageResidencyManager residency(2 * (1 << 20) + 256);
+    std::vector<std::unique_ptr<ImageProxy>> large;
+    for (int i = 1; i <= 3; ++i) {
+        large.push_back(std::make_unique<ImageProxy>("large" + std::to_string(i) + ".jpg", nullptr, &residency));
+    }
+    large[0]->display();
+    large[1]->display();
+    large[0]->display();  // large1 becomes most recently displayed
+    large[2]->display();  // over budget: unloads large2, the least recently displayed
+    std::cout << large[1]->getInfo() << std::endl;
+    large[1]->display();  // reloaded on demand, unloads large1
+    ResidencyStats rs = residency.getStats();
+    std::cout << "Residency stats: resident=" << rs.residentBytes << " peak=" << rs.peakBytes
+              << " loads=" << rs.loads << " evictions=" << rs.evictions << std::endl;
+
+    // 5. Real files are memory-mapped instead of simulated
+    std::cout << "\n5. Zero-copy mmap loading of a real file:" << std::endl;
+    std::string bigFile = (std::filesystem::temp_directory_path() / "proxy_demo_large.raw").string();
+    {
+        std::vector<char> block(1 << 20);
+        for (size_t i = 0; i < block.size(); ++i) block[i] = static_cast<char>(i * 31);
+        std::ofstream out(bigFile, std::ios::binary);
+        for (int i = 0; i < 256; ++i) out.write(block.data(), static_cast<std::streamsize>(block.size()));
+    }
+    ImageProxy realFile(bigFile);
+    realFile.display();
+    auto mappedImage = realFile.realImageHandle();
+    std::cout << "Span over " << mappedImage->bytes().data.size() << " mapped bytes" << std::endl;
+    runFileLoadBenchmark(bigFile);
+    std::filesystem::remove(bigFile);
+
+    // 6. Two galleries of the same files share one RealImage per filename
+    std::cout << "\n6. Deduplicating registry, two galleries loading concurrently:" << std::endl;
+    ImageRegistry registry;
+    IoThreadPool dedupPool(4);
+    std::vector<std::unique_ptr<ImageProxy>> galleryA, galleryB;
+    for (int i = 1; i <= 2; ++i) {
+        std::string name = "shared" + std::to_string(i) + ".jpg";
+        galleryA.push_back(std::make_unique<ImageProxy>(name, &dedupPool, nullptr, &registry));
+        galleryB.push_back(std::make_unique<ImageProxy>(name, &dedupPool, nullptr, &registry));
+    }
+    std::vector<std::shared_future<void>> dedupLoads;
+    for (size_t i = 0; i < galleryA.size(); ++i) {
+        dedupLoads.push_back(galleryA[i]->loadAsync());
+        dedupLoads.push_back(galleryB[i]->loadAsync());
+    }
+    for (auto& f : dedupLoads) f.wait();
+    bool sameInstance = galleryA[0]->realImageHandle() == galleryB[0]->realImageHandle();
+    std::cout << "Same instance: " << std::boolalpha << sameInstance << std::endl;
+    RegistryStats gs = registry.getStats();
+    std::cout << "Registry stats: created=" << gs.created << " shared=" << gs.shared << " pruned=" << gs.pruned << std::endl;
     return 0;
 }
@@ -3,9 +3,213 @@
 #include <memory>
 #include <unordered_map>
 #include <vector>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+#include <fstream>
+#include <filesystem>
+#include <span>
+#include <string_view>
 
 // Protection Proxy example - controls access based on permissions
 enum class UserRole { GUEST, USER, ADMIN };
+
+// Operations as bits, so everything a role may do to one document fits in one byte
+enum Permission : uint8_t {
+    PERM_READ = 1 << 0,
+    PERM_WRITE = 1 << 1,
+    PERM_DELETE = 1 << 2,
+};
+using PermissionMask = uint8_t;
+
+inline const char* roleToString(UserRole role) {
+    switch (role) {
+        case UserRole::GUEST: return "GUEST";
+        case UserRole::USER: return "USER";
+        case UserRole::ADMIN: return "ADMIN";
+        default: return "UNKNOWN";
+    }
+}
+
+inline const char* permissionToString(Permission op) {
+    switch (op) {
+        case PERM_READ: return "read";
+        case PERM_WRITE: return "write";
+        case PERM_DELETE: return "delete";
+        default: return "unknown";
+    }
+}
+
+// One row of the rule table: for `role`, the listed operations on documents whose filename
+// matches `pattern` (glob: '*' any run, '?' any one char) are allowed or denied.
+struct AccessRule {
+    UserRole role;
+    PermissionMask operations;
+    std::string pattern;
+    bool allow;
+};
+
+inline bool globMatch(std::string_view pattern, std::string_view text) {
+    size_t p = 0, t = 0, starP = std::string_view::npos, starT = 0;
+    while (t < text.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t])) {
+            ++p;
+            ++t;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            starP = p++;
+            starT = t;
+        } else if (starP != std::string_view::npos) {
+            p = starP + 1;
+            t = ++starT;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') ++p;
+    return p == pattern.size();
+}
+
+// A rule pattern classified once, so batch checks can use plain prefix/suffix/substring
+// searches (memcmp/memchr-based, vectorised by the C library) instead of the general glob
+struct CompiledPattern {
+    enum class Kind { All, Exact, Prefix, Suffix, Contains, Glob } kind;
+    std::string literal;  // the pattern without its surrounding '*' (Glob keeps it whole)
+
+    explicit CompiledPattern(const std::string& pattern) {
+        bool wild = pattern.find_first_of("*?") != std::string::npos;
+        bool lead = !pattern.empty() && pattern.front() == '*';
+        bool trail = pattern.size() > 1 && pattern.back() == '*';
+        std::string inner = pattern.substr(lead ? 1 : 0, pattern.size() - (lead ? 1 : 0) - (trail ? 1 : 0));
+        if (pattern == "*") {
+            kind = Kind::All;
+        } else if (!wild) {
+            kind = Kind::Exact;
+        } else if (inner.find_first_of("*?") != std::string::npos) {
+            kind = Kind::Glob;
+        } else if (lead && trail) {
+            kind = Kind::Contains;
+        } else if (trail) {
+            kind = Kind::Prefix;
+        } else {
+            kind = Kind::Suffix;
+        }
+        literal = kind == Kind::Glob ? pattern : inner;
+    }
+
+    bool matches(std::string_view name) const {
+        switch (kind) {
+            case Kind::All: return true;
+            case Kind::Exact: return name == literal;
+            case Kind::Prefix: return name.substr(0, literal.size()) == literal;
+            case Kind::Suffix:
+                return name.size() >= literal.size() && name.substr(name.size() - literal.size()) == literal;
+            case Kind::Contains: return name.find(literal) != std::string_view::npos;
+            default: return globMatch(literal, name);
+        }
+    }
+};
+
+// Immutable rule table; never modified after publication, so readers need no lock
+struct PolicySnapshot {
+    std::vector<AccessRule> rules;
+    uint64_t version = 0;
+
+    // For each operation the first matching rule decides; no match means deny
+    PermissionMask compile(UserRole role, const std::string& filename) const {
+        PermissionMask allowed = 0;
+        PermissionMask decided = 0;
+        for (const auto& rule : rules) {
+            PermissionMask open = rule.operations & ~decided;
+            if (rule.role != role || !open || !globMatch(rule.pattern, filename)) continue;
+            if (rule.allow) allowed |= open;
+            decided |= open;
+        }
+        return allowed;
+    }
+
+    // Batch form of compile() for one operation: bit i says whether filenames[i] is allowed.
+    // Rules are filtered to (role, op) once, then applied column-wise: each rule makes one tight
+    // pass over the entries still undecided, so the cost follows the data, not the call count.
+    std::vector<bool> authorizeMany(UserRole role, std::span<const std::string> filenames, Permission op) const {
+        std::vector<bool> allowed(filenames.size(), false);
+        std::vector<uint32_t> undecided(filenames.size());
+        for (uint32_t i = 0; i < undecided.size(); ++i) undecided[i] = i;
+
+        for (const auto& rule : rules) {
+            if (rule.role != role || !(rule.operations & op)) continue;
+            CompiledPattern pattern(rule.pattern);
+            size_t kept = 0;
+            for (uint32_t index : undecided) {
+                if (pattern.matches(filenames[index])) {
+                    allowed[index] = rule.allow;
+                } else {
+                    undecided[kept++] = index;  // compact in place for the next rule
+                }
+            }
+            undecided.resize(kept);
+            if (undecided.empty()) break;
+        }
+        return allowed;  // anything still undecided is denied
+    }
+};
+
+// Table-driven policy with read-copy-update reloads.
+// reload() builds a new snapshot and publishes it with one atomic pointer swap; readers that
+// still hold the old snapshot keep using it until they drop their reference (the shared_ptr
+// is the grace period). Proxies only compare version() on the hot path, so a check against an
+// unchanged policy is lock-free. The first check after a reload fetches the snapshot to
+// recompile, and std::atomic<std::shared_ptr> is not lock-free on common implementations.
+class AccessPolicy {
+private:
+    std::atomic<std::shared_ptr<const PolicySnapshot>> current_;
+    std::atomic<uint64_t> version_{0};
+    std::mutex writerMutex_;  // serialises reloads; readers never touch it
+
+public:
+    // The rules the proxy used to hardcode
+    static std::vector<AccessRule> defaultRules() {
+        return {
+            {UserRole::GUEST, PERM_READ, "*confidential*", false},
+            {UserRole::GUEST, PERM_READ, "*", true},
+            {UserRole::USER, PERM_READ | PERM_WRITE, "*", true},
+            {UserRole::ADMIN, PERM_READ | PERM_WRITE | PERM_DELETE, "*", true},
+        };
+    }
+
+    explicit AccessPolicy(std::vector<AccessRule> rules = defaultRules()) {
+        reload(std::move(rules));
+    }
+
+    // Shared default used by proxies that are not given a policy
+    static AccessPolicy& global() {
+        static AccessPolicy policy;
+        return policy;
+    }
+
+    void reload(std::vector<AccessRule> rules) {
+        std::lock_guard<std::mutex> lock(writerMutex_);
+        auto next = std::make_shared<PolicySnapshot>();
+        next->rules = std::move(rules);
+        next->version = version_.load(std::memory_order_relaxed) + 1;
+        current_.store(std::move(next));
+        version_.store(version_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    uint64_t version() const { return version_.load(std::memory_order_acquire); }
+
+    std::shared_ptr<const PolicySnapshot> snapshot() const { return current_.load(); }
+
+    // Authorise a whole listing against one consistent snapshot
+    std::vector<bool> authorizeMany(UserRole role, std::span<const std::string> filenames, Permission op) const {
+        return snapshot()->authorizeMany(role, filenames, op);
+    }
+};
+
 //subject interface defines common operations,
 // Defines the common interface that both Real Subject and Proxy implement
 class SecureDocument {
@@ -43,6 +247,203 @@ public:
         content_.clear();
     }
 };
+// One access decision, fixed size so it can be copied into a ring slot without allocating
+struct AuditEvent {
+    uint64_t timestampNs;
+    uint32_t thread;
+    UserRole role;
+    Permission op;
+    bool allowed;
+    bool truncated;           // document holds only a prefix of the name
+    uint32_t documentLength;  // full name length in bytes
+    uint64_t documentHash;    // FNV-1a of the full name, tells apart names sharing a prefix
+    char document[64];  // possibly truncated at a UTF-8 boundary, always NUL-terminated
+};
+
+// Single-producer / single-consumer ring: the owning request thread pushes, the audit
+// writer pops. Head and tail live on separate cache lines; push never blocks, it fails when full.
+class AuditRing {
+private:
+    std::vector<AuditEvent> slots_;
+    size_t mask_;
+    alignas(64) std::atomic<size_t> head_{0};  // next slot to write (producer)
+    alignas(64) std::atomic<size_t> tail_{0};  // next slot to read (consumer)
+    alignas(64) std::atomic<size_t> dropped_{0};
+
+public:
+    explicit AuditRing(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        slots_.resize(size);
+        mask_ = size - 1;
+    }
+
+    bool push(const AuditEvent& event) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == slots_.size()) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        slots_[head & mask_] = event;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename Fn>
+    size_t drain(Fn&& fn) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t head = head_.load(std::memory_order_acquire);
+        for (size_t i = tail; i != head; ++i) fn(slots_[i & mask_]);
+        tail_.store(head, std::memory_order_release);
+        return head - tail;
+    }
+
+    size_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+};
+
+struct AuditStats {
+    size_t written = 0;
+    size_t dropped = 0;  // ring was full; the request went ahead without waiting
+    size_t rings = 0;    // one per thread that has recorded an event
+};
+
+// Audit trail that never stalls the request path. Each thread records into its own ring
+// (registered once, on its first event); a background writer drains all rings to a JSONL file.
+class AuditLog {
+private:
+    static inline std::atomic<uint64_t> nextId_{1};
+    const uint64_t id_ = nextId_++;
+    size_t ringCapacity_;
+    std::vector<std::unique_ptr<AuditRing>> rings_;  // owned here, so threads may exit freely
+    std::mutex ringsMutex_;                          // registration and the writer only
+    std::ofstream out_;
+    std::atomic<size_t> written_{0};
+    std::atomic<bool> stopping_{false};
+    std::thread writer_;
+
+    AuditRing& ringForThisThread() {
+        struct Cached { uint64_t logId; AuditRing* ring; };
+        thread_local std::vector<Cached> cache;
+        for (const auto& c : cache) {
+            if (c.logId == id_) return *c.ring;
+        }
+        std::lock_guard<std::mutex> lock(ringsMutex_);
+        rings_.push_back(std::make_unique<AuditRing>(ringCapacity_));
+        cache.push_back({id_, rings_.back().get()});
+        return *rings_.back();
+    }
+
+    static uint32_t threadNumber() {
+        static std::atomic<uint32_t> next{0};
+        thread_local uint32_t number = next++;
+        return number;
+    }
+
+    static constexpr char kHexDigits[] = "0123456789abcdef";
+
+    static uint64_t fnv1a(std::string_view s) {
+        uint64_t h = 1469598103934665603ULL;
+        for (unsigned char c : s) {
+            h ^= c;
+            h *= 1099511628211ULL;
+        }
+        return h;
+    }
+
+    void writeEvent(const AuditEvent& e) {
+        out_ << "{\"ts_ns\":" << e.timestampNs << ",\"thread\":" << e.thread
+             << ",\"role\":\"" << roleToString(e.role) << "\",\"op\":\"" << permissionToString(e.op)
+             << "\",\"allowed\":" << (e.allowed ? "true" : "false") << ",\"document\":\"";
+        for (const char* c = e.document; *c; ++c) {
+            unsigned char ch = static_cast<unsigned char>(*c);
+            if (ch == '"' || ch == '\\') {
+                out_ << '\\' << *c;
+            } else if (ch < 0x20 || ch == 0x7f) {
+                // Control characters would break the one-record-per-line format
+                out_ << "\\u00" << kHexDigits[ch >> 4] << kHexDigits[ch & 0xf];
+            } else {
+                out_ << *c;
+            }
+        }
+        out_ << '"';
+        if (e.truncated) {
+            char digits[16];
+            for (int i = 0; i < 16; ++i) digits[i] = kHexDigits[(e.documentHash >> (60 - 4 * i)) & 0xf];
+            out_ << ",\"document_truncated\":true,\"document_length\":" << e.documentLength
+                 << ",\"document_hash\":\"" << std::string_view(digits, sizeof(digits)) << '"';
+        }
+        out_ << "}\n";
+    }
+
+    // The consumer side of every ring (and the file) is only touched under ringsMutex_
+    size_t drainAll(bool flushFile) {
+        size_t n = 0;
+        std::lock_guard<std::mutex> lock(ringsMutex_);
+        for (auto& ring : rings_) {
+            n += ring->drain([this](const AuditEvent& e) { writeEvent(e); });
+        }
+        written_ += n;
+        if (flushFile || n == 0) out_.flush();
+        return n;
+    }
+
+    void writerLoop() {
+        while (!stopping_.load()) {
+            if (drainAll(false) == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+        }
+        drainAll(true);
+    }
+
+public:
+    explicit AuditLog(const std::string& path, size_t ringCapacity = 4096)
+        : ringCapacity_(ringCapacity), out_(path, std::ios::app) {
+        writer_ = std::thread(&AuditLog::writerLoop, this);
+    }
+
+    // Producers must be done recording before the log is destroyed
+    ~AuditLog() {
+        stopping_ = true;
+        writer_.join();
+    }
+
+    AuditLog(const AuditLog&) = delete;
+    AuditLog& operator=(const AuditLog&) = delete;
+
+    void record(UserRole role, Permission op, bool allowed, const std::string& document) {
+        AuditEvent e{};
+        e.timestampNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        e.thread = threadNumber();
+        e.role = role;
+        e.op = op;
+        e.allowed = allowed;
+        size_t n = std::min(document.size(), sizeof(e.document) - 1);
+        if (n < document.size()) {
+            // Cut before a UTF-8 continuation byte, never inside a multi-byte sequence
+            while (n > 0 && (static_cast<unsigned char>(document[n]) & 0xC0) == 0x80) --n;
+            e.truncated = true;
+            e.documentLength = static_cast<uint32_t>(std::min<size_t>(document.size(), UINT32_MAX));
+            e.documentHash = fnv1a(document);
+        }
+        std::memcpy(e.document, document.data(), n);
+        ringForThisThread().push(e);
+    }
+
+    // Writes out everything recorded so far, on the calling thread
+    void flush() { drainAll(true); }
+
+    AuditStats getStats() {
+        AuditStats s;
+        s.written = written_.load();
+        std::lock_guard<std::mutex> lock(ringsMutex_);
+        for (const auto& ring : rings_) s.dropped += ring->dropped();
+        s.rings = rings_.size();
+        return s;
+    }
+};
+
 // Virtual Proxy - controls access and permissions
 //Controls access to the Real Subject and can add additional behavior
 class DocumentProxy : public SecureDocument {
@@ -50,6 +451,22 @@ private:
     std::unique_ptr<RealDocument> realDocument_;
     std::string filename_;
     UserRole userRole_;
+    const AccessPolicy& policy_;
+    // (policy version << 8) | permission mask, in one word so concurrent checks see a
+    // consistent pair; compiled when built, recompiled when the policy changes
+    mutable std::atomic<uint64_t> compiled_{0};
+    AuditLog* audit_;  // when set, decisions go to the audit trail instead of stdout; not owned
+
+    // Returns the word it stored, so the caller tests that rather than re-reading compiled_
+    // (another thread may have replaced it in between)
+    uint64_t recompile() const {
+        auto snapshot = policy_.snapshot();
+        PermissionMask mask = snapshot->compile(userRole_, filename_);
+        uint64_t compiled = (snapshot->version << 8) | mask;
+        compiled_.store(compiled, std::memory_order_relaxed);
+        return compiled;
+    }
+
     RealDocument* getRealDocument() {
         if (!realDocument_) {
             realDocument_ = std::make_unique<RealDocument>(filename_);
@@ -57,45 +474,51 @@ private:
         return realDocument_.get();
     }
 
-    std::string roleToString(UserRole role) const {
-        switch (role) {
-            case UserRole::GUEST: return "GUEST";
-            case UserRole::USER: return "USER";
-            case UserRole::ADMIN: return "ADMIN";
-            default: return "UNKNOWN";
+public:
+    DocumentProxy(const std::string& filename, UserRole role, const AccessPolicy& policy = AccessPolicy::global(),
+                  AuditLog* audit = nullptr)
+        : filename_(filename), userRole_(role), policy_(policy), audit_(audit) {
+        std::cout << "DocumentProxy created with role: " << roleToString(role) << std::endl;
+        recompile();  // compile the permission mask up front
+    }
+
+    // Hot path, safe from any number of threads: an atomic load, a version compare and a bit
+    // test. Lock-free until a reload, after which one check per proxy fetches the snapshot.
+    bool isAllowed(Permission op) const {
+        uint64_t compiled = compiled_.load(std::memory_order_relaxed);
+        if ((compiled >> 8) != policy_.version()) {
+            compiled = recompile();
         }
+        return (compiled & op) != 0;
     }
 
-public:
-    DocumentProxy(const std::string& filename, UserRole role) 
-        : filename_(filename), userRole_(role) {
-        std::cout << "DocumentProxy created with role: " << roleToString(role) << std::endl;
+    // Checks op and records the decision, without performing the operation
+    bool authorize(Permission op) const {
+        bool allowed = isAllowed(op);
+        if (audit_) {
+            audit_->record(userRole_, op, allowed, filename_);
+        } else {
+            std::cout << "Proxy: Checking " << permissionToString(op) << " permissions..." << std::endl;
+            if (!allowed) {
+                std::cout << "Access denied: " << roleToString(userRole_) << " cannot "
+                          << permissionToString(op) << " " << filename_ << std::endl;
+            }
+        }
+        return allowed;
     }
 
     void read() override {
-        std::cout << "Proxy: Checking read permissions..." << std::endl;
-        if (userRole_ == UserRole::GUEST && filename_.find("confidential") != std::string::npos) {
-            std::cout << "Access denied: Guests cannot read confidential documents" << std::endl;
-            return;
-        }
+        if (!authorize(PERM_READ)) return;
         getRealDocument()->read();
     }
 
     void write(const std::string& content) override {
-        std::cout << "Proxy: Checking write permissions..." << std::endl;
-        if (userRole_ == UserRole::GUEST) {
-            std::cout << "Access denied: Guests cannot write documents" << std::endl;
-            return;
-        }
+        if (!authorize(PERM_WRITE)) return;
         getRealDocument()->write(content);
     }
 
     void deleteDoc() override {
-        std::cout << "Proxy: Checking delete permissions..." << std::endl;
-        if (userRole_ != UserRole::ADMIN) {
-            std::cout << "Access denied: Only admins can delete documents" << std::endl;
-            return;
-        }
+        if (!authorize(PERM_DELETE)) return;
         getRealDocument()->deleteDoc();
     }
     
@@ -125,5 +548,102 @@ int main(){
     adminDoc->write("New admin content");
     adminDoc->deleteDoc();
     adminDoc->read();  // Should show empty content after deletion
+
+    std::cout << "\nPolicy change: users may now delete ordinary documents:" << std::endl;
+    auto userPlainDoc = std::make_unique<DocumentProxy>("notes.txt", UserRole::USER);
+    userPlainDoc->deleteDoc();  // denied under the default policy
+    auto rules = AccessPolicy::defaultRules();
+    rules.insert(rules.begin(), AccessRule{UserRole::USER, PERM_DELETE, "*", true});
+    rules.insert(rules.begin(), AccessRule{UserRole::USER, PERM_DELETE, "*confidential*", false});
+    AccessPolicy::global().reload(rules);
+    userPlainDoc->deleteDoc();  // mask recompiled on first use after the change
+
+    // Hot reload under load: reader threads check permissions while an admin swaps tables
+    std::cout << "\nConcurrent checks during policy reloads:" << std::endl;
+    AccessPolicy livePolicy;
+    std::vector<std::unique_ptr<DocumentProxy>> docs;
+    for (int i = 0; i < 16; ++i) {
+        docs.push_back(std::make_unique<DocumentProxy>(
+            (i % 4 ? "doc" : "confidential_doc") + std::to_string(i) + ".txt", UserRole::GUEST, livePolicy));
+    }
+    std::atomic<bool> stop{false};
+    std::atomic<size_t> checks{0};
+    std::atomic<size_t> granted{0};
+    std::vector<std::thread> readers;
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            size_t local = 0, allowed = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                for (auto& doc : docs) allowed += doc->isAllowed(PERM_READ);
+                local += docs.size();
+            }
+            checks += local;
+            granted += allowed;
+        });
+    }
+    int reloads = 0;
+    for (; reloads < 200; ++reloads) {
+        auto r = AccessPolicy::defaultRules();
+        if (reloads % 2) r.insert(r.begin(), AccessRule{UserRole::GUEST, PERM_READ, "doc1*", false});
+        livePolicy.reload(std::move(r));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    stop = true;
+    for (auto& r : readers) r.join();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << checks.load() << " checks across 4 threads during " << reloads << " reloads ("
+              << static_cast<size_t>(checks.load() / secs) << " checks/s, " << granted.load() << " granted)" << std::endl;
+
+    // Audit trail: 4 threads authorize without waiting on I/O; a writer thread drains to JSONL
+    std::cout << "\nAudited decisions (per-thread lock-free rings -> JSONL):" << std::endl;
+    std::string auditPath = (std::filesystem::temp_directory_path() / "document_audit.jsonl").string();
+    std::filesystem::remove(auditPath);
+    AuditStats as;
+    {
+        AuditLog audit(auditPath, 1 << 16);
+        auto audited = std::make_unique<DocumentProxy>("confidential_plan.txt", UserRole::GUEST,
+                                                       AccessPolicy::global(), &audit);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < 4; ++t) {
+            workers.emplace_back([&audited] {
+                for (int i = 0; i < 50000; ++i) {
+                    audited->authorize(i % 2 ? PERM_READ : PERM_WRITE);
+                }
+            });
+        }
+        for (auto& w : workers) w.join();
+        audited.reset();
+        audit.flush();
+        as = audit.getStats();
+    }
+    std::cout << "Audit stats: written=" << as.written << " dropped=" << as.dropped
+              << " rings=" << as.rings << std::endl;
+    std::ifstream auditFile(auditPath);
+    std::string firstLine;
+    std::getline(auditFile, firstLine);
+    std::cout << "First record: " << firstLine << std::endl;
+
+    // Batch authorization of a 10,000 entry directory listing
+    std::cout << "\nBatch authorization of a directory listing:" << std::endl;
+    std::vector<std::string> listing;
+    for (int i = 0; i < 10000; ++i) {
+        listing.push_back((i % 10 == 0 ? "confidential_" : "report_") + std::to_string(i) + ".txt");
+    }
+    auto policySnapshot = AccessPolicy::global().snapshot();
+    auto batchStart = std::chrono::steady_clock::now();
+    size_t perFileAllowed = 0;
+    for (const auto& name : listing) {
+        perFileAllowed += (policySnapshot->compile(UserRole::GUEST, name) & PERM_READ) != 0;
+    }
+    auto perFileUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - batchStart).count();
+    batchStart = std::chrono::steady_clock::now();
+    std::vector<bool> visible = AccessPolicy::global().authorizeMany(UserRole::GUEST, listing, PERM_READ);
+    auto batchUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - batchStart).count();
+    size_t batchAllowed = std::count(visible.begin(), visible.end(), true);
+    std::cout << "Per-file checks: " << perFileAllowed << " visible in " << perFileUs << " us" << std::endl;
+    std::cout << "authorizeMany:   " << batchAllowed << " visible in " << batchUs << " us" << std::endl;
     return 0;
 }
\ No newline at end of file
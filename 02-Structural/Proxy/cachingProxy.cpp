@@ -5,11 +5,51 @@
 #include <vector>
 #include <chrono>
 #include <thread>
+#include <list>
+#include <optional>
+#include <iterator>
+#include <mutex>
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <atomic>
+#include <stdexcept>
+#include <condition_variable>
+#include <deque>
+#include <unordered_set>
+#include <span>
+#include <string_view>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <new>
+#include <cmath>
+#include <random>
+#include <filesystem>
+// POSIX, for the memory-mapped persistent tier; other platforms build without it
+#if defined(__unix__) || defined(__APPLE__)
+#define PROXY_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define PROXY_HAS_MMAP 0
+#endif
 // Caching Proxy example
 class WebService {
 public:
     virtual ~WebService() = default;
     virtual std::string getData(const std::string& url) = 0;
+    // Batched lookup, results in request order. Default falls back to one call per URL.
+    virtual std::vector<std::string> getMany(std::span<const std::string_view> urls) {
+        std::vector<std::string> results;
+        results.reserve(urls.size());
+        for (auto url : urls) {
+            results.push_back(getData(std::string(url)));
+        }
+        return results;
+    }
 };
 
 class RealWebService : public WebService {
@@ -18,31 +58,907 @@ public:
         std::cout << "Fetching data from: " << url << std::endl;
         // Simulate network delay
         std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        if (url.find("/error") != std::string::npos) {
+            throw std::runtime_error("Backend error for " + url);
+        }
         return "Data from " + url;
     }
+
+    // One batched request: all URLs travel in a single round-trip and are served concurrently
+    // on the backend, so the caller pays one network delay instead of N. Any failing URL fails the batch.
+    std::vector<std::string> getMany(std::span<const std::string_view> urls) override {
+        std::cout << "Batch fetching " << urls.size() << " URLs in one round-trip" << std::endl;
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        std::vector<std::string> results;
+        results.reserve(urls.size());
+        for (auto url : urls) {
+            if (url.find("/error") != std::string_view::npos) {
+                throw std::runtime_error("Backend error for " + std::string(url));
+            }
+            results.push_back("Data from " + std::string(url));
+        }
+        return results;
+    }
+};
+
+// Cached payloads are immutable and shared: a hit hands out a reference, not a copy
+using Payload = std::shared_ptr<const std::string>;
+
+// Transparent hash so string-keyed maps can be probed with a std::string_view, no temporary key
+struct StringHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+};
+template <typename V>
+using StringMap = std::unordered_map<std::string, V, StringHash, std::equal_to<>>;
+
+enum class EvictionPolicy {
+    Lru,       // plain recency; a one-off scan can flush every hot entry
+    WTinyLfu   // small LRU window + frequency-gated main cache, scan resistant
+};
+
+// Tunables for the eviction engine; a zero limit means "unbounded" for that dimension
+struct CacheConfig {
+    size_t maxEntries = 1024;
+    size_t maxBytes = 16 * 1024 * 1024;
+    EvictionPolicy policy = EvictionPolicy::Lru;
+    std::chrono::milliseconds ttl = std::chrono::minutes(5);  // hard TTL: never served past this
+    // Stale-while-revalidate: past softTtl an entry is still served but refreshed in the
+    // background. Zero disables it (entries are simply fresh until ttl).
+    std::chrono::milliseconds softTtl = std::chrono::milliseconds(0);
+    size_t shards = 1;  // > 1 splits the cache into hash-partitioned, independently locked shards
+    // Optional persistent second tier (see MappedDiskCache); empty path disables it
+    std::string persistPath;
+    bool logRequests = true;  // print hit/miss lines (off for benchmarks)
+};
+
+struct CacheStats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;    // dropped to stay within entry/byte budget
+    size_t expirations = 0;  // dropped because their TTL ran out
+    size_t entries = 0;
+    size_t bytes = 0;
+    size_t backendCalls = 0;     // fetches that actually reached RealWebService
+    size_t coalescedWaits = 0;   // misses that joined an in-flight fetch instead (= backend calls saved)
+    size_t staleHits = 0;        // hits served past softTtl
+    size_t refreshes = 0;        // background revalidations completed
+    size_t diskHits = 0;         // memory misses answered by the persistent tier
+    size_t admissionRejects = 0; // W-TinyLFU: window victims that lost to the main cache victim
+};
+
+struct CacheLookup {
+    Payload value;
+    bool stale = false;  // past softTtl, caller should trigger a refresh
+};
+
+// Count-min sketch of access frequency (4 rows of 4-bit-style saturating counters).
+// Every sampleSize increments all counters are halved, so old popularity fades away.
+class FrequencySketch {
+private:
+    static constexpr uint8_t kMaxCount = 15;
+    static constexpr uint64_t kSeeds[4] = {0x9E3779B97F4A7C15ULL, 0xC2B2AE3D27D4EB4FULL,
+                                           0x165667B19E3779F9ULL, 0x27D4EB2F165667C5ULL};
+    std::vector<uint8_t> table_;  // 4 rows laid out back to back
+    size_t width_ = 0;            // power of two
+    size_t additions_ = 0;
+    size_t sampleSize_ = 0;
+
+    size_t slot(size_t row, uint64_t hash) const {
+        uint64_t h = (hash + kSeeds[row]) * kSeeds[(row + 1) & 3];
+        return row * width_ + ((h >> 32) & (width_ - 1));
+    }
+
+    void age() {
+        for (auto& c : table_) c >>= 1;
+        additions_ /= 2;
+    }
+
+public:
+    explicit FrequencySketch(size_t capacity) {
+        width_ = 16;
+        while (width_ < capacity) width_ <<= 1;
+        table_.assign(4 * width_, 0);
+        sampleSize_ = 10 * std::max<size_t>(capacity, 1);
+    }
+
+    void increment(std::string_view key) {
+        uint64_t hash = std::hash<std::string_view>{}(key);
+        bool added = false;
+        for (size_t row = 0; row < 4; ++row) {
+            uint8_t& c = table_[slot(row, hash)];
+            if (c < kMaxCount) {
+                ++c;
+                added = true;
+            }
+        }
+        if (added && ++additions_ >= sampleSize_) age();
+    }
+
+    uint8_t estimate(std::string_view key) const {
+        uint64_t hash = std::hash<std::string_view>{}(key);
+        uint8_t freq = kMaxCount;
+        for (size_t row = 0; row < 4; ++row) {
+            freq = std::min(freq, table_[slot(row, hash)]);
+        }
+        return freq;
+    }
+};
+
+// Bounded LRU + TTL store
+// Lists keep recency order (front = most recent), map points into the lists so
+// lookup, touch and evict are all O(1). Expired entries are reclaimed lazily on access.
+// With EvictionPolicy::Lru everything lives in one list. With WTinyLfu new entries enter a
+// window (~1% of capacity); window victims are admitted to the main cache (probation +
+// protected segments, SLRU) only if the frequency sketch rates them above the main victim.
+class LruTtlCache {
+private:
+    using Clock = std::chrono::steady_clock;
+    enum class Segment : uint8_t { Window, Probation, Protected };
+    struct Entry {
+        std::string key;
+        Payload value;
+        Clock::time_point staleAt;
+        Clock::time_point expiresAt;
+        Segment segment = Segment::Window;
+    };
+    using EntryList = std::list<Entry>;
+
+    CacheConfig config_;
+    EntryList window_;     // the only list under Lru
+    EntryList probation_;  // main cache, seen once since admission
+    EntryList protected_;  // main cache, hit again while on probation
+    StringMap<EntryList::iterator> index_;
+    CacheStats stats_;
+    std::optional<FrequencySketch> sketch_;
+    size_t windowCap_ = 0;
+    size_t protectedCap_ = 0;
+
+    static size_t footprint(const Entry& e) {
+        return e.key.size() + e.value->size();
+    }
+
+    EntryList& listFor(Segment segment) {
+        switch (segment) {
+            case Segment::Probation: return probation_;
+            case Segment::Protected: return protected_;
+            default: return window_;
+        }
+    }
+
+    void moveTo(EntryList::iterator it, Segment segment) {
+        listFor(segment).splice(listFor(segment).begin(), listFor(it->segment), it);
+        it->segment = segment;
+    }
+
+    void erase(EntryList::iterator it) {
+        stats_.bytes -= footprint(*it);
+        index_.erase(index_.find(it->key));
+        listFor(it->segment).erase(it);
+    }
+
+    void evict(EntryList::iterator it) {
+        erase(it);
+        ++stats_.evictions;
+    }
+
+    bool tinyLfu() const { return sketch_.has_value(); }
+
+    size_t entryCount() const { return window_.size() + probation_.size() + protected_.size(); }
+
+    // Window overflow: its LRU entry competes with the main cache's LRU entry for a slot
+    void admitFromWindow() {
+        auto candidate = std::prev(window_.end());
+        size_t mainCap = config_.maxEntries - windowCap_;
+        if (probation_.size() + protected_.size() < mainCap) {
+            moveTo(candidate, Segment::Probation);
+            return;
+        }
+        EntryList& victims = !probation_.empty() ? probation_ : protected_;
+        if (victims.empty()) {
+            evict(candidate);
+            return;
+        }
+        auto victim = std::prev(victims.end());
+        if (sketch_->estimate(candidate->key) > sketch_->estimate(victim->key)) {
+            evict(victim);
+            moveTo(candidate, Segment::Probation);
+        } else {
+            evict(candidate);
+            ++stats_.admissionRejects;
+        }
+    }
+
+    void enforceBudget() {
+        if (tinyLfu()) {
+            while (window_.size() > windowCap_) admitFromWindow();
+        } else {
+            while (config_.maxEntries && window_.size() > config_.maxEntries) {
+                evict(std::prev(window_.end()));
+            }
+        }
+        // Byte budget: evict from the coldest segment; an entry larger than the whole budget is not kept
+        while (config_.maxBytes && stats_.bytes > config_.maxBytes) {
+            EntryList& coldest = !probation_.empty() ? probation_ : !protected_.empty() ? protected_ : window_;
+            evict(std::prev(coldest.end()));
+        }
+    }
+
+public:
+    explicit LruTtlCache(const CacheConfig& config = CacheConfig{}) : config_(config) {
+        if (config.policy == EvictionPolicy::WTinyLfu && config.maxEntries > 1) {
+            windowCap_ = std::max<size_t>(1, config.maxEntries / 100);
+            protectedCap_ = (config.maxEntries - windowCap_) * 8 / 10;
+            sketch_.emplace(config.maxEntries);
+        }
+    }
+
+    // Allocation-free on a hit: string_view probe, shared payload returned by reference count
+    std::optional<CacheLookup> get(std::string_view key) {
+        if (sketch_) sketch_->increment(key);
+        auto found = index_.find(key);
+        if (found == index_.end()) {
+            ++stats_.misses;
+            return std::nullopt;
+        }
+        auto it = found->second;
+        auto now = Clock::now();
+        if (now >= it->expiresAt) {
+            erase(it);
+            ++stats_.expirations;
+            ++stats_.misses;
+            return std::nullopt;
+        }
+        // Move to front, iterators stay valid; a probation hit is promoted to protected
+        if (it->segment == Segment::Probation) {
+            moveTo(it, Segment::Protected);
+            if (protected_.size() > protectedCap_) {
+                moveTo(std::prev(protected_.end()), Segment::Probation);
+            }
+        } else {
+            moveTo(it, it->segment);
+        }
+        ++stats_.hits;
+        bool stale = now >= it->staleAt;
+        if (stale) ++stats_.staleHits;
+        return CacheLookup{it->value, stale};
+    }
+
+    // A fresh (not yet stale) value, without touching recency, frequency or stats; used to
+    // re-check after a miss, so it must not count as a second lookup
+    Payload peekFresh(std::string_view key) const {
+        auto found = index_.find(key);
+        if (found == index_.end() || Clock::now() >= found->second->staleAt) return nullptr;
+        return found->second->value;
+    }
+
+    // age > 0 for a value that was fetched earlier (e.g. promoted from the persistent tier):
+    // its soft and hard deadlines are counted from the original fetch, not from now
+    void put(std::string_view key, Payload value, std::chrono::milliseconds age = std::chrono::milliseconds(0)) {
+        auto found = index_.find(key);
+        if (found != index_.end()) {
+            erase(found->second);
+        }
+        auto fetchedAt = Clock::now() - age;
+        auto softTtl = config_.softTtl.count() > 0 ? std::min(config_.softTtl, config_.ttl) : config_.ttl;
+        window_.push_front(Entry{std::string(key), std::move(value), fetchedAt + softTtl, fetchedAt + config_.ttl});
+        index_.emplace(window_.front().key, window_.begin());
+        stats_.bytes += footprint(window_.front());
+        enforceBudget();
+    }
+
+    void clear() {
+        window_.clear();
+        probation_.clear();
+        protected_.clear();
+        index_.clear();
+        stats_.bytes = 0;
+    }
+
+    size_t size() const { return entryCount(); }
+
+    CacheStats stats() const {
+        CacheStats s = stats_;
+        s.entries = entryCount();
+        return s;
+    }
+};
+
+// Thread-safe wrapper: keys are hash-partitioned over N shards, each with its own lock,
+// so threads touching different shards never contend. Budgets are split evenly per shard.
+// Note: LRU get() reorders the list, so even a hit needs exclusive access to its shard.
+class ShardedLruTtlCache {
+private:
+    struct Shard {
+        std::mutex mutex;
+        LruTtlCache cache;
+        explicit Shard(const CacheConfig& config) : cache(config) {}
+    };
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+    Shard& shardFor(std::string_view key) const {
+        return *shards_[std::hash<std::string_view>{}(key) % shards_.size()];
+    }
+
+public:
+    explicit ShardedLruTtlCache(const CacheConfig& config = CacheConfig{}) {
+        size_t n = std::max<size_t>(1, config.shards);
+        CacheConfig perShard = config;
+        perShard.maxEntries = (config.maxEntries + n - 1) / n;
+        perShard.maxBytes = (config.maxBytes + n - 1) / n;
+        for (size_t i = 0; i < n; ++i) {
+            shards_.push_back(std::make_unique<Shard>(perShard));
+        }
+    }
+
+    std::optional<CacheLookup> get(std::string_view key) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.cache.get(key);
+    }
+
+    Payload peekFresh(std::string_view key) const {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.cache.peekFresh(key);
+    }
+
+    void put(std::string_view key, Payload value, std::chrono::milliseconds age = std::chrono::milliseconds(0)) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.cache.put(key, std::move(value), age);
+    }
+
+    void clear() {
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            shard->cache.clear();
+        }
+    }
+
+    size_t size() const {
+        return stats().entries;
+    }
+
+    // Sum of per-shard stats; each shard is locked in turn, so this is not an atomic snapshot
+    CacheStats stats() const {
+        CacheStats total;
+        for (const auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            CacheStats s = shard->cache.stats();
+            total.hits += s.hits;
+            total.misses += s.misses;
+            total.evictions += s.evictions;
+            total.expirations += s.expirations;
+            total.entries += s.entries;
+            total.bytes += s.bytes;
+            total.staleHits += s.staleHits;
+            total.admissionRejects += s.admissionRejects;
+        }
+        return total;
+    }
+
+    size_t shardCount() const { return shards_.size(); }
+};
+
+#if PROXY_HAS_MMAP
+// Persistent second tier (POSIX mmap)
+// <path> is an append-only log of records:  [RecordHeader][key bytes][value bytes]
+// <path>.idx is an open-addressing hash index (FNV-1a, linear probing) of {hash, offset} slots.
+// Both files are mmap'ed at startup, so a warm restart parses nothing: lookups probe the index
+// and compare keys directly in the mapped log. A newer record for a key simply repoints its slot.
+// If the index is missing or behind the log (e.g. a crash between append and index update),
+// the unindexed tail is rescanned; a torn final record is truncated away.
+class MappedDiskCache {
+private:
+    static constexpr uint64_t kLogMagic = 0x31474F4C59585250ULL;    // "PRXYLOG1"
+    static constexpr uint64_t kIndexMagic = 0x3158444959585250ULL;  // "PRXYIDX1"
+    static constexpr uint64_t kInitialSlots = 1024;
+    static constexpr size_t kMinLogMap = 1 << 20;
+
+    struct RecordHeader {
+        uint64_t hash;
+        int64_t writtenAtMs;  // system_clock, so TTL survives restarts
+        uint32_t keyLen;
+        uint32_t valueLen;
+    };
+    struct IndexHeader {
+        uint64_t magic;
+        uint64_t slotCount;     // power of two
+        uint64_t used;
+        uint64_t indexedBytes;  // log prefix covered by the index
+    };
+    struct Slot {
+        uint64_t hash;
+        uint64_t offset;  // 0 = empty (offset 0 is the log magic, never a record)
+    };
+
+    std::string logPath_;
+    std::string indexPath_;
+    int logFd_ = -1;
+    int indexFd_ = -1;
+    uint64_t logSize_ = 0;
+    const char* logMap_ = nullptr;
+    size_t logMapLen_ = 0;
+    IndexHeader* index_ = nullptr;
+    size_t indexMapLen_ = 0;
+    std::chrono::milliseconds ttl_;
+    std::mutex mutex_;
+
+    static uint64_t fnv1a(std::string_view key) {
+        uint64_t h = 1469598103934665603ULL;
+        for (unsigned char c : key) {
+            h ^= c;
+            h *= 1099511628211ULL;
+        }
+        return h;
+    }
+
+    Slot* slots() const { return reinterpret_cast<Slot*>(index_ + 1); }
+
+    void unmapLog() {
+        if (logMap_) munmap(const_cast<char*>(logMap_), logMapLen_);
+        logMap_ = nullptr;
+        logMapLen_ = 0;
+    }
+
+    // Appends go through write(), so the read mapping is extended lazily when it falls behind.
+    // It is mapped ahead of the file in doubling steps: a shared mapping past EOF picks up the
+    // appended bytes, so a remap happens O(log size) times instead of on every put. Only
+    // [0, logSize_) is ever read; pages wholly past EOF would fault.
+    bool ensureLogMapped(uint64_t end) {
+        if (end <= logMapLen_) return true;
+        size_t len = std::max({static_cast<size_t>(end), 2 * logMapLen_, kMinLogMap});
+        unmapLog();
+        void* p = mmap(nullptr, len, PROT_READ, MAP_SHARED, logFd_, 0);
+        if (p == MAP_FAILED) return false;
+        logMap_ = static_cast<const char*>(p);
+        logMapLen_ = len;
+        return true;
+    }
+
+    bool mapIndex(uint64_t slotCount, bool create) {
+        if (index_) munmap(index_, indexMapLen_);
+        index_ = nullptr;
+        indexMapLen_ = sizeof(IndexHeader) + slotCount * sizeof(Slot);
+        if (create && ftruncate(indexFd_, 0) != 0) return false;
+        if (ftruncate(indexFd_, static_cast<off_t>(indexMapLen_)) != 0) return false;
+        void* p = mmap(nullptr, indexMapLen_, PROT_READ | PROT_WRITE, MAP_SHARED, indexFd_, 0);
+        if (p == MAP_FAILED) return false;
+        index_ = static_cast<IndexHeader*>(p);
+        if (create) {
+            *index_ = IndexHeader{kIndexMagic, slotCount, 0, sizeof(kLogMagic)};
+        }
+        return true;
+    }
+
+    void indexRecord(uint64_t hash, uint64_t offset, std::string_view key) {
+        uint64_t mask = index_->slotCount - 1;
+        for (uint64_t i = hash & mask;; i = (i + 1) & mask) {
+            Slot& slot = slots()[i];
+            if (slot.offset == 0) {
+                slot = Slot{hash, offset};
+                ++index_->used;
+                return;
+            }
+            if (slot.hash == hash && keyAt(slot.offset) == key) {
+                slot.offset = offset;  // newer record wins
+                return;
+            }
+        }
+    }
+
+    // Records are packed back to back, so headers are read with memcpy rather than cast in place
+    RecordHeader headerAt(uint64_t offset) const {
+        RecordHeader h;
+        std::memcpy(&h, logMap_ + offset, sizeof(h));
+        return h;
+    }
+
+    std::string_view keyAt(uint64_t offset) const {
+        return std::string_view(logMap_ + offset + sizeof(RecordHeader), headerAt(offset).keyLen);
+    }
+
+    // Index every complete record in [from, logSize_); truncate a torn tail
+    bool scanFrom(uint64_t from) {
+        if (!ensureLogMapped(logSize_)) return false;
+        uint64_t pos = from;
+        while (pos + sizeof(RecordHeader) <= logSize_) {
+            RecordHeader h = headerAt(pos);
+            uint64_t end = pos + sizeof(RecordHeader) + h.keyLen + h.valueLen;
+            if (end > logSize_) break;
+            if (index_->used * 10 >= index_->slotCount * 7) grow();
+            indexRecord(h.hash, pos, keyAt(pos));
+            pos = end;
+            index_->indexedBytes = pos;
+        }
+        if (pos != logSize_) {
+            std::cout << "Disk cache: truncating torn record at offset " << pos << std::endl;
+            if (ftruncate(logFd_, static_cast<off_t>(pos)) != 0) return false;
+            logSize_ = pos;
+            unmapLog();
+            if (!ensureLogMapped(logSize_)) return false;
+        }
+        index_->indexedBytes = pos;
+        return true;
+    }
+
+    void grow() {
+        uint64_t newSlots = index_->slotCount * 2;
+        uint64_t indexedBytes = index_->indexedBytes;
+        mapIndex(newSlots, true);
+        index_->indexedBytes = sizeof(kLogMagic);
+        for (uint64_t pos = sizeof(kLogMagic); pos < indexedBytes;) {
+            RecordHeader h = headerAt(pos);
+            indexRecord(h.hash, pos, keyAt(pos));
+            pos += sizeof(RecordHeader) + h.keyLen + h.valueLen;
+        }
+        index_->indexedBytes = indexedBytes;
+    }
+
+    bool open() {
+        logFd_ = ::open(logPath_.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+        indexFd_ = ::open(indexPath_.c_str(), O_RDWR | O_CREAT, 0644);
+        if (logFd_ < 0 || indexFd_ < 0) return false;
+
+        struct stat st{};
+        fstat(logFd_, &st);
+        logSize_ = static_cast<uint64_t>(st.st_size);
+        uint64_t magic = 0;
+        if (logSize_ < sizeof(magic) || pread(logFd_, &magic, sizeof(magic), 0) != sizeof(magic) ||
+            magic != kLogMagic) {
+            // New or unrecognised log: start over
+            if (ftruncate(logFd_, 0) != 0 || ::write(logFd_, &kLogMagic, sizeof(kLogMagic)) != sizeof(kLogMagic)) {
+                return false;
+            }
+            logSize_ = sizeof(kLogMagic);
+        }
+
+        fstat(indexFd_, &st);
+        IndexHeader ih{};
+        bool indexOk = static_cast<size_t>(st.st_size) >= sizeof(ih) &&
+                       pread(indexFd_, &ih, sizeof(ih), 0) == sizeof(ih) && ih.magic == kIndexMagic &&
+                       ih.slotCount && (ih.slotCount & (ih.slotCount - 1)) == 0 &&
+                       static_cast<size_t>(st.st_size) == sizeof(ih) + ih.slotCount * sizeof(Slot) &&
+                       ih.indexedBytes <= logSize_;
+        if (!(indexOk ? mapIndex(ih.slotCount, false) : mapIndex(kInitialSlots, true))) return false;
+        return scanFrom(index_->indexedBytes);
+    }
+
+    void close() {
+        unmapLog();
+        if (index_) munmap(index_, indexMapLen_);
+        index_ = nullptr;
+        if (logFd_ >= 0) ::close(logFd_);
+        if (indexFd_ >= 0) ::close(indexFd_);
+        logFd_ = indexFd_ = -1;
+    }
+
+public:
+    struct Record {
+        std::string value;
+        int64_t writtenAtMs;  // lets the memory tier keep the original deadlines
+    };
+
+    static int64_t nowMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    MappedDiskCache(const std::string& path, std::chrono::milliseconds ttl)
+        : logPath_(path), indexPath_(path + ".idx"), ttl_(ttl) {
+        if (!open()) {
+            std::cout << "Disk cache: cannot open " << path << ", persistent tier disabled" << std::endl;
+            close();
+        }
+    }
+
+    ~MappedDiskCache() { close(); }
+
+    MappedDiskCache(const MappedDiskCache&) = delete;
+    MappedDiskCache& operator=(const MappedDiskCache&) = delete;
+
+    bool isOpen() const { return index_ != nullptr; }
+
+    size_t size() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return index_ ? index_->used : 0;
+    }
+
+    // The value is copied out under the lock because a later append may remap the log
+    std::optional<Record> get(std::string_view key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!index_) return std::nullopt;
+        uint64_t hash = fnv1a(key);
+        uint64_t mask = index_->slotCount - 1;
+        for (uint64_t i = hash & mask;; i = (i + 1) & mask) {
+            const Slot& slot = slots()[i];
+            if (slot.offset == 0) return std::nullopt;
+            if (slot.hash != hash || keyAt(slot.offset) != key) continue;
+            RecordHeader h = headerAt(slot.offset);
+            if (nowMs() - h.writtenAtMs >= ttl_.count()) return std::nullopt;
+            return Record{std::string(logMap_ + slot.offset + sizeof(RecordHeader) + h.keyLen, h.valueLen), h.writtenAtMs};
+        }
+    }
+
+    void put(std::string_view key, std::string_view value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!index_) return;
+        RecordHeader h{fnv1a(key), nowMs(), static_cast<uint32_t>(key.size()),
+                       static_cast<uint32_t>(value.size())};
+        std::string record(reinterpret_cast<const char*>(&h), sizeof(h));
+        record.append(key).append(value);
+        if (::write(logFd_, record.data(), record.size()) != static_cast<ssize_t>(record.size())) {
+            return;  // a short write is recovered as a torn record on next open
+        }
+        uint64_t offset = logSize_;
+        logSize_ += record.size();
+        if (!ensureLogMapped(logSize_)) return;
+        if (index_->used * 10 >= index_->slotCount * 7) grow();
+        indexRecord(h.hash, offset, key);
+        index_->indexedBytes = logSize_;
+    }
+};
+#else
+// No mmap on this platform (e.g. Windows): the persistent tier reports itself disabled and
+// the proxy runs memory-only
+class MappedDiskCache {
+public:
+    struct Record {
+        std::string value;
+        int64_t writtenAtMs;
+    };
+
+    static int64_t nowMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    MappedDiskCache(const std::string& path, std::chrono::milliseconds) {
+        std::cout << "Disk cache: no mmap support, persistent tier at " << path << " disabled" << std::endl;
+    }
+
+    bool isOpen() const { return false; }
+    size_t size() { return 0; }
+    std::optional<Record> get(std::string_view) { return std::nullopt; }
+    void put(std::string_view, std::string_view) {}
 };
+#endif
 
 class CachingWebServiceProxy : public WebService {
 private:
     std::unique_ptr<RealWebService> realService_;
-    mutable std::unordered_map<std::string, std::string> cache_;
+    mutable ShardedLruTtlCache cache_;  // safe to share one proxy across threads
+    std::unique_ptr<MappedDiskCache> disk_;  // optional persistent tier, checked after a memory miss
+    std::atomic<size_t> diskHits_{0};
+    std::chrono::milliseconds softTtl_;
+    bool logRequests_;
+
+    // Single-flight table: at most one backend fetch per key; concurrent missers wait on its future
+    std::mutex inflightMutex_;
+    StringMap<std::shared_future<Payload>> inflight_;
+    std::atomic<size_t> backendCalls_{0};
+    std::atomic<size_t> coalescedWaits_{0};
+
+    // Background revalidation: one worker drains a de-duplicated queue of stale keys
+    std::mutex refreshMutex_;
+    std::condition_variable refreshCv_;
+    std::deque<std::string> refreshQueue_;
+    std::unordered_set<std::string> refreshPending_;
+    bool stopping_ = false;
+    std::atomic<size_t> refreshes_{0};
+    std::thread refreshWorker_;
+
+    void scheduleRefresh(const std::string& url) {
+        {
+            std::lock_guard<std::mutex> lock(refreshMutex_);
+            if (!refreshPending_.insert(url).second) return;  // already queued
+            refreshQueue_.push_back(url);
+        }
+        refreshCv_.notify_one();
+    }
+
+    void refreshLoop() {
+        std::unique_lock<std::mutex> lock(refreshMutex_);
+        while (true) {
+            refreshCv_.wait(lock, [this] { return stopping_ || !refreshQueue_.empty(); });
+            if (stopping_) return;
+            std::string url = std::move(refreshQueue_.front());
+            refreshQueue_.pop_front();
+            lock.unlock();
+            try {
+                fetchOnce(url);  // shares the single-flight table with foreground misses
+                ++refreshes_;
+            } catch (const std::exception& e) {
+                // Keep serving the stale copy until the hard TTL; next stale hit retries
+                std::cout << "Background refresh failed: " << e.what() << std::endl;
+            }
+            lock.lock();
+            refreshPending_.erase(url);
+        }
+    }
+
+    Payload fetchOnce(std::string_view url) {
+        std::promise<Payload> promise;
+        {
+            std::unique_lock<std::mutex> lock(inflightMutex_);
+            auto it = inflight_.find(url);
+            if (it != inflight_.end()) {
+                std::shared_future<Payload> pending = it->second;
+                lock.unlock();
+                ++coalescedWaits_;
+                if (logRequests_) std::cout << "Joining in-flight fetch for: " << url << std::endl;
+                return pending.get();  // rethrows the leader's exception, if any
+            }
+            // A leader may have stored the value and retired its entry since our cache miss
+            if (auto fresh = cache_.peekFresh(url)) return fresh;
+            inflight_.emplace(std::string(url), promise.get_future().share());
+        }
+
+        // This caller is the leader for url
+        ++backendCalls_;
+        try {
+            auto data = std::make_shared<const std::string>(realService_->getData(std::string(url)));
+            cache_.put(url, data);  // Store in cache before retiring the in-flight entry
+            if (disk_) disk_->put(url, *data);
+            promise.set_value(data);
+            std::lock_guard<std::mutex> lock(inflightMutex_);
+            inflight_.erase(inflight_.find(url));
+            return data;
+        } catch (...) {
+            promise.set_exception(std::current_exception());  // failures are not cached
+            std::lock_guard<std::mutex> lock(inflightMutex_);
+            inflight_.erase(inflight_.find(url));
+            throw;
+        }
+    }
+
+    // Cache lookup shared by getShared and getMany; stale hits also schedule a refresh.
+    // Returns nullptr on a miss in both tiers.
+    Payload lookupCached(std::string_view url) {
+        auto cached = cache_.get(url);
+        if (!cached) {
+            if (!disk_) return nullptr;
+            auto persisted = disk_->get(url);
+            if (!persisted) return nullptr;
+            if (logRequests_) std::cout << "Disk cache hit for: " << url << std::endl;
+            ++diskHits_;
+            auto data = std::make_shared<const std::string>(std::move(persisted->value));
+            // Promote to the memory tier with the age it already has, so the hard TTL still holds
+            auto age = std::chrono::milliseconds(std::max<int64_t>(0, MappedDiskCache::nowMs() - persisted->writtenAtMs));
+            cache_.put(url, data, age);
+            if (softTtl_.count() > 0 && age >= softTtl_ && refreshWorker_.joinable()) {
+                scheduleRefresh(std::string(url));
+            }
+            return data;
+        }
+        if (cached->stale && refreshWorker_.joinable()) {
+            if (logRequests_) std::cout << "Stale hit for: " << url << " (refreshing in background)" << std::endl;
+            scheduleRefresh(std::string(url));
+        } else if (logRequests_) {
+            std::cout << "Cache hit for: " << url << std::endl;
+        }
+        return std::move(cached->value);
+    }
 
 public:
-    CachingWebServiceProxy() : realService_(std::make_unique<RealWebService>()) {}
+    explicit CachingWebServiceProxy(const CacheConfig& config = CacheConfig{})
+        : realService_(std::make_unique<RealWebService>()), cache_(config),
+          softTtl_(config.softTtl), logRequests_(config.logRequests) {
+        if (!config.persistPath.empty()) {
+            disk_ = std::make_unique<MappedDiskCache>(config.persistPath, config.ttl);
+            std::cout << "Persistent tier at " << config.persistPath << " holds "
+                      << disk_->size() << " entries" << std::endl;
+        }
+        if (config.softTtl.count() > 0) {
+            refreshWorker_ = std::thread(&CachingWebServiceProxy::refreshLoop, this);
+        }
+    }
+
+    ~CachingWebServiceProxy() override {
+        {
+            std::lock_guard<std::mutex> lock(refreshMutex_);
+            stopping_ = true;
+        }
+        refreshCv_.notify_all();
+        if (refreshWorker_.joinable()) refreshWorker_.join();
+    }
 
+    CachingWebServiceProxy(const CachingWebServiceProxy&) = delete;
+    CachingWebServiceProxy& operator=(const CachingWebServiceProxy&) = delete;
+
+    // WebService interface: returns an owned copy of the shared payload
     std::string getData(const std::string& url) override {
+        return *getShared(url);
+    }
+
+    // Preferred on hot paths: no key string is built and a hit performs no heap allocation
+    Payload getShared(std::string_view url) {
         // Check cache first
-        auto it = cache_.find(url);
-        if (it != cache_.end()) {
-            std::cout << "Cache hit for: " << url << std::endl;
-            return it->second;
+        if (auto cached = lookupCached(url)) {
+            return cached;
         }
 
-        // Cache miss - fetch from real service
-        std::cout << "Cache miss for: " << url << std::endl;
-        std::string data = realService_->getData(url);
-        cache_[url] = data;  // Store in cache
-        return data;
+        // Cache miss (or expired) - fetch from real service, sharing any fetch already in flight
+        if (logRequests_) std::cout << "Cache miss for: " << url << std::endl;
+        return fetchOnce(url);
+    }
+
+    // Hits are answered from the cache; all misses this call leads go to the backend as
+    // one batch. Misses already in flight (from other callers) are joined, not refetched.
+    std::vector<std::string> getMany(std::span<const std::string_view> urls) override {
+        std::vector<std::string> results(urls.size());
+        std::vector<std::string> batch;                      // URLs this call fetches
+        std::vector<std::promise<Payload>> promises;         // parallel to batch
+        StringMap<size_t> batchIndex;                        // URL -> position in batch
+        std::vector<std::pair<size_t, size_t>> fromBatch;    // result slot -> batch position
+        std::vector<std::pair<size_t, std::shared_future<Payload>>> joined;
+
+        for (size_t i = 0; i < urls.size(); ++i) {
+            std::string_view url = urls[i];
+            if (auto cached = lookupCached(url)) {
+                results[i] = *cached;
+                continue;
+            }
+            auto dup = batchIndex.find(url);
+            if (dup != batchIndex.end()) {
+                fromBatch.emplace_back(i, dup->second);
+                continue;
+            }
+            std::lock_guard<std::mutex> lock(inflightMutex_);
+            auto it = inflight_.find(url);
+            if (it != inflight_.end()) {
+                joined.emplace_back(i, it->second);
+                ++coalescedWaits_;
+                continue;
+            }
+            if (auto fresh = cache_.peekFresh(url)) {  // stored by a leader since our miss
+                results[i] = *fresh;
+                continue;
+            }
+            promises.emplace_back();
+            inflight_.emplace(std::string(url), promises.back().get_future().share());
+            batchIndex.emplace(std::string(url), batch.size());
+            fromBatch.emplace_back(i, batch.size());
+            batch.emplace_back(url);
+        }
+
+        if (logRequests_) {
+            std::cout << "getMany: " << urls.size() << " requested, " << batch.size() << " fetched, "
+                      << joined.size() << " joined in-flight" << std::endl;
+        }
+
+        if (!batch.empty()) {
+            std::vector<std::string_view> batchViews(batch.begin(), batch.end());
+            ++backendCalls_;
+            std::vector<std::string> fetched;
+            try {
+                fetched = realService_->getMany(batchViews);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(inflightMutex_);
+                for (size_t b = 0; b < batch.size(); ++b) {
+                    promises[b].set_exception(std::current_exception());
+                    inflight_.erase(inflight_.find(batch[b]));
+                }
+                throw;
+            }
+            for (size_t b = 0; b < batch.size(); ++b) {
+                auto data = std::make_shared<const std::string>(fetched[b]);
+                cache_.put(batch[b], data);
+                if (disk_) disk_->put(batch[b], fetched[b]);
+                promises[b].set_value(std::move(data));
+            }
+            {
+                std::lock_guard<std::mutex> lock(inflightMutex_);
+                for (const auto& url : batch) inflight_.erase(inflight_.find(url));
+            }
+            for (auto [slot, pos] : fromBatch) results[slot] = fetched[pos];
+        }
+
+        for (auto& [slot, pending] : joined) {
+            results[slot] = *pending.get();  // rethrows the other leader's exception, if any
+        }
+        return results;
     }
 
     void clearCache() {
@@ -53,8 +969,174 @@ public:
     size_t getCacheSize() const {
         return cache_.size();
     }
+
+    CacheStats getStats() const {
+        CacheStats s = cache_.stats();
+        s.backendCalls = backendCalls_.load();
+        s.coalescedWaits = coalescedWaits_.load();
+        s.refreshes = refreshes_.load();
+        s.diskHits = diskHits_.load();
+        return s;
+    }
 };
 
+// Allocation counter for the hit-path benchmark: replaces the global operator new for this program
+// (noinline keeps GCC from pairing the inlined malloc/free and warning about mismatched new/delete)
+static std::atomic<size_t> g_allocations{0};
+
+[[gnu::noinline]] void* operator new(size_t size) {
+    ++g_allocations;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+[[gnu::noinline]] void operator delete(void* p) noexcept { std::free(p); }
+[[gnu::noinline]] void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+void printStats(const CacheStats& s) {
+    std::cout << "Cache stats: entries=" << s.entries << " bytes=" << s.bytes
+              << " hits=" << s.hits << " misses=" << s.misses
+              << " evictions=" << s.evictions << " expirations=" << s.expirations
+              << " backendCalls=" << s.backendCalls << " coalesced=" << s.coalescedWaits
+              << " staleHits=" << s.staleHits << " refreshes=" << s.refreshes
+              << " diskHits=" << s.diskHits << " admissionRejects=" << s.admissionRejects << std::endl;
+}
+
+// Hit-path benchmark: every thread reads pre-warmed keys. Compares the original
+// single-threaded unordered_map with the sharded cache at 1 shard (one global lock) and N shards.
+void runShardedBenchmark() {
+    using Clock = std::chrono::steady_clock;
+    const size_t keyCount = 4096;
+    const size_t lookupsPerThread = 200000;
+    const unsigned threads = std::max(2u, std::thread::hardware_concurrency());
+
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < keyCount; ++i) {
+        keys.push_back("https://api.example.com/item/" + std::to_string(i));
+    }
+
+    auto opsPerSec = [](size_t ops, Clock::duration d) {
+        double secs = std::chrono::duration<double>(d).count();
+        return static_cast<size_t>(ops / (secs > 0 ? secs : 1e-9));
+    };
+
+    std::unordered_map<std::string, std::string> plainMap;
+    for (const auto& k : keys) plainMap[k] = "Data from " + k;
+    size_t found = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < lookupsPerThread; ++i) {
+        found += plainMap.count(keys[i % keyCount]);
+    }
+    std::cout << "unordered_map, 1 thread:        "
+              << opsPerSec(lookupsPerThread, Clock::now() - start) << " ops/s" << std::endl;
+
+    for (size_t shardCount : {size_t(1), size_t(threads * 4)}) {
+        CacheConfig config;
+        config.maxEntries = keyCount * 2;
+        config.shards = shardCount;
+        ShardedLruTtlCache cache(config);
+        for (const auto& k : keys) cache.put(k, std::make_shared<const std::string>("Data from " + k));
+
+        std::vector<std::thread> workers;
+        start = Clock::now();
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&cache, &keys, t, keyCount, lookupsPerThread] {
+                for (size_t i = 0; i < lookupsPerThread; ++i) {
+                    cache.get(keys[(i * 7 + t * 131) % keyCount]);
+                }
+            });
+        }
+        for (auto& w : workers) w.join();
+        std::cout << "sharded cache, " << shardCount << " shard(s), " << threads << " threads: "
+                  << opsPerSec(lookupsPerThread * threads, Clock::now() - start) << " ops/s" << std::endl;
+    }
+    if (found != lookupsPerThread) std::cout << "unexpected miss in baseline map" << std::endl;
+}
+
+// Counts heap allocations per cache hit: the string_view + shared payload path against the
+// std::string interface, which has to build a key and copy the payload on every call
+void runAllocationBenchmark() {
+    const size_t iterations = 100000;
+    CacheConfig quiet;
+    quiet.logRequests = false;
+    CachingWebServiceProxy proxy(quiet);
+    const std::string key = "https://api.example.com/users/profile/settings";
+    proxy.getShared(key);  // warm the cache (one backend fetch)
+
+    std::string_view view = key;
+    size_t before = g_allocations.load();
+    size_t bytes = 0;
+    for (size_t i = 0; i < iterations; ++i) {
+        bytes += proxy.getShared(view)->size();
+    }
+    size_t sharedAllocs = g_allocations.load() - before;
+
+    const char* literal = "https://api.example.com/users/profile/settings";
+    before = g_allocations.load();
+    for (size_t i = 0; i < iterations; ++i) {
+        bytes += proxy.getData(literal).size();  // temporary key + payload copy
+    }
+    size_t copyAllocs = g_allocations.load() - before;
+
+    std::cout << "getShared(string_view): " << static_cast<double>(sharedAllocs) / iterations
+              << " allocations per hit" << std::endl;
+    std::cout << "getData(std::string):   " << static_cast<double>(copyAllocs) / iterations
+              << " allocations per hit" << std::endl;
+    if (bytes == 0) std::cout << "unexpected empty payloads" << std::endl;
+}
+
+// Trace replay: hit ratio of Lru vs WTinyLfu at the same capacity. Each access is a get,
+// followed by a put on a miss, exactly as the proxy drives the cache.
+void runAdmissionBenchmark() {
+    const size_t keySpace = 100000;
+    const size_t capacity = 1000;
+    const size_t accesses = 300000;
+    std::mt19937_64 rng(42);
+
+    // Zipf(s = 0.99) sampler over [0, keySpace) via inverse CDF
+    std::vector<double> cdf(keySpace);
+    double sum = 0;
+    for (size_t k = 0; k < keySpace; ++k) {
+        sum += 1.0 / std::pow(static_cast<double>(k + 1), 0.99);
+        cdf[k] = sum;
+    }
+    std::uniform_real_distribution<double> uniform(0.0, sum);
+    auto zipf = [&] {
+        return static_cast<size_t>(std::lower_bound(cdf.begin(), cdf.end(), uniform(rng)) - cdf.begin());
+    };
+
+    std::vector<std::string> zipfTrace;
+    std::vector<std::string> scanTrace;
+    size_t scanKey = keySpace;  // scan keys are never repeated
+    for (size_t i = 0; i < accesses; ++i) {
+        zipfTrace.push_back("https://api.example.com/item/" + std::to_string(zipf()));
+        // Scan-heavy: every 5000 accesses a crawler sweeps 2000 one-off URLs
+        if (i % 5000 < 2000) {
+            scanTrace.push_back("https://api.example.com/item/" + std::to_string(scanKey++));
+        } else {
+            scanTrace.push_back(zipfTrace.back());
+        }
+    }
+
+    auto replay = [&](const std::vector<std::string>& trace, EvictionPolicy policy) {
+        CacheConfig config;
+        config.maxEntries = capacity;
+        config.maxBytes = 0;
+        config.policy = policy;
+        LruTtlCache cache(config);
+        auto payload = std::make_shared<const std::string>("payload");
+        for (const auto& key : trace) {
+            if (!cache.get(key)) cache.put(key, payload);
+        }
+        CacheStats s = cache.stats();
+        return 100.0 * s.hits / (s.hits + s.misses);
+    };
+
+    std::cout << "capacity " << capacity << ", " << keySpace << " keys, " << accesses << " accesses" << std::endl;
+    for (auto [name, trace] : {std::pair{"Zipf(0.99)", &zipfTrace}, std::pair{"Zipf + scans", &scanTrace}}) {
+        std::cout << name << ": LRU hit ratio " << replay(*trace, EvictionPolicy::Lru) << "%, W-TinyLFU "
+                  << replay(*trace, EvictionPolicy::WTinyLfu) << "%" << std::endl;
+    }
+}
 
 int main(){
      // 3. Caching Proxy
@@ -75,6 +1157,104 @@ int main(){
     std::cout << "Received: " << data3 << std::endl;
     
     std::cout << "\nCache size: " << webProxy.getCacheSize() << std::endl;
+    printStats(webProxy.getStats());
+
+    // Bounded cache: only 2 entries and a short TTL
+    std::cout << "\nBounded cache (2 entries, 1.5s TTL):" << std::endl;
+    CacheConfig small;
+    small.maxEntries = 2;
+    small.ttl = std::chrono::milliseconds(1500);
+    CachingWebServiceProxy boundedProxy(small);
+    boundedProxy.getData("https://api.example.com/a");
+    boundedProxy.getData("https://api.example.com/b");
+    boundedProxy.getData("https://api.example.com/a");  // hit, a becomes most recent
+    boundedProxy.getData("https://api.example.com/c");  // evicts b (least recently used)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1600));
+    boundedProxy.getData("https://api.example.com/a");  // expired, refetched
+    printStats(boundedProxy.getStats());
+
+    // Shared proxy: several threads hit one sharded instance concurrently
+    // Concurrent cold misses on the same URL are coalesced into one backend fetch
+    std::cout << "\nShared sharded proxy, 4 threads missing on the same URL:" << std::endl;
+    CacheConfig shared;
+    shared.shards = 8;
+    CachingWebServiceProxy sharedProxy(shared);
+    std::vector<std::thread> callers;
+    for (int t = 0; t < 4; ++t) {
+        callers.emplace_back([&sharedProxy] { sharedProxy.getData("https://api.example.com/users"); });
+    }
+    for (auto& c : callers) c.join();
+
+    // A failing fetch is reported to every waiter
+    callers.clear();
+    for (int t = 0; t < 3; ++t) {
+        callers.emplace_back([&sharedProxy] {
+            try {
+                sharedProxy.getData("https://api.example.com/error");
+            } catch (const std::exception& e) {
+                std::cout << "Caught: " << e.what() << std::endl;
+            }
+        });
+    }
+    for (auto& c : callers) c.join();
+    printStats(sharedProxy.getStats());
+
+    // Stale-while-revalidate: after softTtl the old value is returned immediately
+    std::cout << "\nStale-while-revalidate (soft TTL 300ms, hard TTL 5s):" << std::endl;
+    CacheConfig swr;
+    swr.softTtl = std::chrono::milliseconds(300);
+    swr.ttl = std::chrono::seconds(5);
+    CachingWebServiceProxy swrProxy(swr);
+    swrProxy.getData("https://api.example.com/feed");
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    auto swrStart = std::chrono::steady_clock::now();
+    swrProxy.getData("https://api.example.com/feed");  // stale, served without waiting on the backend
+    auto swrMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - swrStart).count();
+    std::cout << "Stale response latency: " << swrMs << " ms" << std::endl;
+    std::this_thread::sleep_for(std::chrono::milliseconds(700));  // let the refresh land
+    swrProxy.getData("https://api.example.com/feed");  // fresh again
+    printStats(swrProxy.getStats());
+
+    // Batched fan-out: 2 cached + 3 new URLs cost a single backend round-trip
+    std::cout << "\nBatched getMany:" << std::endl;
+    std::vector<std::string_view> page = {
+        "https://api.example.com/users", "https://api.example.com/posts",
+        "https://api.example.com/comments", "https://api.example.com/likes",
+        "https://api.example.com/tags"};
+    auto batchStart = std::chrono::steady_clock::now();
+    auto pageData = webProxy.getMany(page);
+    auto batchMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - batchStart).count();
+    std::cout << "Received " << pageData.size() << " results in " << batchMs << " ms" << std::endl;
+    printStats(webProxy.getStats());
+
+    // Persistent tier: a second proxy instance (a "restart") is served from the mmap'ed file
+    std::cout << "\nPersistent mmap tier across a restart:" << std::endl;
+    CacheConfig persistent;
+    persistent.persistPath = (std::filesystem::temp_directory_path() / "caching_proxy_demo.dat").string();
+    std::filesystem::remove(persistent.persistPath);
+    std::filesystem::remove(persistent.persistPath + ".idx");
+    {
+        CachingWebServiceProxy firstRun(persistent);
+        firstRun.getData("https://api.example.com/profile");
+        firstRun.getData("https://api.example.com/settings");
+    }
+    {
+        CachingWebServiceProxy warmRestart(persistent);
+        warmRestart.getData("https://api.example.com/profile");   // from disk, no backend call
+        warmRestart.getData("https://api.example.com/settings");
+        printStats(warmRestart.getStats());
+    }
+
+    std::cout << "\nHit-path throughput benchmark:" << std::endl;
+    runShardedBenchmark();
+
+    std::cout << "\nHit-path allocation benchmark:" << std::endl;
+    runAllocationBenchmark();
+
+    std::cout << "\nAdmission policy trace replay:" << std::endl;
+    runAdmissionBenchmark();
 
     std::cout << "\n=== Proxy Pattern Benefits ===" << std::endl;
     std::cout << "- Lazy Loading: Objects created only when needed" << std::endl;